@@ -7,10 +7,17 @@
 #include "ArduinoJson/version.hpp"
 
 #include "ArduinoJson/DynamicJsonBuffer.hpp"
+#include "ArduinoJson/HugePageAllocator.hpp"
 #include "ArduinoJson/JsonArray.hpp"
+#include "ArduinoJson/JsonFilter.hpp"
+#include "ArduinoJson/JsonHandler.hpp"
 #include "ArduinoJson/JsonObject.hpp"
+#include "ArduinoJson/JsonPushParser.hpp"
+#include "ArduinoJson/JsonSkip.hpp"
+#include "ArduinoJson/PooledAllocator.hpp"
 #include "ArduinoJson/StaticJsonBuffer.hpp"
 
+#include "ArduinoJson/Deserialization/IndexedJsonParser.hpp"
 #include "ArduinoJson/Deserialization/JsonParserImpl.hpp"
 #include "ArduinoJson/JsonArrayImpl.hpp"
 #include "ArduinoJson/JsonBufferImpl.hpp"
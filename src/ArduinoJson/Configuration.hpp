@@ -39,11 +39,31 @@
 #define ARDUINOJSON_ENABLE_STD_STREAM 0
 #endif
 
+// Small strings only with parseJsonEvents() and a read-only input
+#ifndef ARDUINOJSON_EVENT_STRING_SIZE
+#define ARDUINOJSON_EVENT_STRING_SIZE 64
+#endif
+
+// The table of the fast float parser is too big for a microcontroller
+#ifndef ARDUINOJSON_ENABLE_FAST_FLOAT
+#define ARDUINOJSON_ENABLE_FAST_FLOAT 0
+#endif
+
 // Limit nesting as the stack is likely to be small
 #ifndef ARDUINOJSON_DEFAULT_NESTING_LIMIT
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
 #endif
 
+// Don't index the arrays, memory is more precious than speed
+#ifndef ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 0
+#endif
+
+// Don't index the objects either
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0
+#endif
+
 #else  // ARDUINOJSON_EMBEDDED_MODE
 
 // On a computer we have plenty of memory so we can use doubles
@@ -79,11 +99,32 @@
 #define ARDUINOJSON_ENABLE_STD_STREAM 1
 #endif
 
+// Strings up to 4KB with parseJsonEvents() and a read-only input
+#ifndef ARDUINOJSON_EVENT_STRING_SIZE
+#define ARDUINOJSON_EVENT_STRING_SIZE 4096
+#endif
+
+// Parse floats with a 10KB table of powers of five, and round them correctly
+#ifndef ARDUINOJSON_ENABLE_FAST_FLOAT
+#define ARDUINOJSON_ENABLE_FAST_FLOAT 1
+#endif
+
 // On a computer, the stack is large so we can increase nesting limit
 #ifndef ARDUINOJSON_DEFAULT_NESTING_LIMIT
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 50
 #endif
 
+// Index the arrays of more than 64 elements, so access by index is O(1)
+#ifndef ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 64
+#endif
+
+// Index the keys of the objects of more than 32 members, so the lookups are
+// O(1)
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 32
+#endif
+
 #endif  // ARDUINOJSON_EMBEDDED_MODE
 
 #ifdef ARDUINO
@@ -130,6 +171,68 @@
 #endif
 #endif
 
+// Use SSE2 (or AVX2) instructions to scan contiguous inputs
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARDUINOJSON_ENABLE_SIMD 1
+#else
+#define ARDUINOJSON_ENABLE_SIMD 0
+#endif
+#endif
+
+// Allow parsing files mapped in memory with mmap()
+#ifndef ARDUINOJSON_ENABLE_MMAP
+#if !ARDUINOJSON_EMBEDDED_MODE && (defined(__unix__) || defined(__APPLE__))
+#define ARDUINOJSON_ENABLE_MMAP 1
+#else
+#define ARDUINOJSON_ENABLE_MMAP 0
+#endif
+#endif
+
+// Enable PooledAllocator, which needs POSIX threads and GCC atomic builtins
+#ifndef ARDUINOJSON_ENABLE_THREAD_POOL
+#if !ARDUINOJSON_EMBEDDED_MODE && (defined(__unix__) || defined(__APPLE__)) && \
+    (defined(__clang__) ||                                                    \
+     (defined(__GNUC__) && __GNUC__ * 100 + __GNUC_MINOR__ >= 407))
+#define ARDUINOJSON_ENABLE_THREAD_POOL 1
+#else
+#define ARDUINOJSON_ENABLE_THREAD_POOL 0
+#endif
+#endif
+
+// Keep memory statistics in JsonBuffer, see JsonBuffer::stats()
+#ifndef ARDUINOJSON_ENABLE_STATISTICS
+#define ARDUINOJSON_ENABLE_STATISTICS 0
+#endif
+
+// Recycle the nodes removed from arrays and objects, and the discarded indexes
+#ifndef ARDUINOJSON_ENABLE_FREE_LISTS
+#define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#endif
+
+// The array index points to every 16th element (see
+// ARDUINOJSON_ARRAY_INDEX_THRESHOLD)
+#ifndef ARDUINOJSON_ARRAY_INDEX_STRIDE
+#define ARDUINOJSON_ARRAY_INDEX_STRIDE 16
+#endif
+
+// Store the type and the value of JsonVariant in 8 bytes, instead of 16 on
+// 64-bit hosts (see JsonVariantData).
+// The integers are limited to 48 bits, the larger ones are stored as doubles.
+#ifndef ARDUINOJSON_ENABLE_NAN_BOXING
+#define ARDUINOJSON_ENABLE_NAN_BOXING 0
+#endif
+
+// Copy the strings of up to 7 chars in JsonVariant, instead of allocating them
+// in the JsonBuffer (see SmallString).
+// CAUTION: as<const char*>() then returns a pointer in the JsonVariant, which
+// is only valid as long as the variant, instead of as long as the JsonBuffer.
+// It has no effect with ARDUINOJSON_ENABLE_NAN_BOXING.
+#ifndef ARDUINOJSON_ENABLE_SMALL_STRINGS
+#define ARDUINOJSON_ENABLE_SMALL_STRINGS 0
+#endif
+
 // Enable deprecated functions by default
 #ifndef ARDUINOJSON_ENABLE_DEPRECATED
 #define ARDUINOJSON_ENABLE_DEPRECATED 1
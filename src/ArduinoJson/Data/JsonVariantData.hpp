@@ -0,0 +1,254 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../Configuration.hpp"
+#include "JsonFloat.hpp"
+#include "JsonInteger.hpp"
+#include "JsonVariantContent.hpp"
+#include "JsonVariantType.hpp"
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t and uintptr_t
+#include <string.h>  // for memcpy and strcpy
+
+namespace ArduinoJson {
+namespace Internals {
+
+#if ARDUINOJSON_ENABLE_NAN_BOXING
+// The type and the value of a JsonVariant, in 8 bytes.
+//
+// A double is stored as is. The other values are stored in the NaNs that a
+// double never has once they are canonicalized: the 16 upper bits are 0xFFF
+// followed by the type plus one, and the 48 lower bits hold the pointer or the
+// integer.
+// The integers whose magnitude doesn't fit in 48 bits are stored as doubles,
+// and lose their lower digits. The pointers must fit in 48 bits, which is the
+// case for the user-space addresses on x86-64 and ARM64.
+class JsonVariantData {
+ public:
+  // The strings are never copied in the variant
+  static const size_t small_string_capacity = 0;
+
+  JsonVariantType type() const {
+    return isBoxed() ? JsonVariantType(((_bits >> 48) & 0xF) - 1) : JSON_FLOAT;
+  }
+
+  JsonFloat asFloat() const {
+    double value;
+    memcpy(&value, &_bits, sizeof(value));
+    return static_cast<JsonFloat>(value);
+  }
+
+  JsonUInt asInteger() const {
+    return static_cast<JsonUInt>(_bits & payloadMask());
+  }
+
+  const char* asString() const {
+    return reinterpret_cast<const char*>(asAddress());
+  }
+
+  JsonArray* asArray() const {
+    return reinterpret_cast<JsonArray*>(asAddress());
+  }
+
+  JsonObject* asObject() const {
+    return reinterpret_cast<JsonObject*>(asAddress());
+  }
+
+  void setUndefined() {
+    _bits = box(JSON_UNDEFINED);
+  }
+
+  void setFloat(JsonFloat value) {
+    double d = value;
+    memcpy(&_bits, &d, sizeof(_bits));
+    if (isBoxed()) _bits = uint64_t(0x7FF8) << 48;  // a NaN
+  }
+
+  // type is JSON_BOOLEAN, JSON_POSITIVE_INTEGER or JSON_NEGATIVE_INTEGER
+  void setInteger(JsonVariantType type, JsonUInt value) {
+    if (static_cast<uint64_t>(value) > payloadMask()) {
+      JsonFloat magnitude = static_cast<JsonFloat>(value);
+      return setFloat(type == JSON_NEGATIVE_INTEGER ? -magnitude : magnitude);
+    }
+    _bits = box(type) | static_cast<uint64_t>(value);
+  }
+
+  // type is JSON_STRING or JSON_UNPARSED
+  void setString(JsonVariantType type, const char* value) {
+    setPointer(type, value);
+  }
+
+  void setSmallString(JsonVariantType type, const char* value) {
+    setString(type, value);
+  }
+
+  bool isSmallString() const {
+    return false;
+  }
+
+  void setArray(JsonArray* value) {
+    setPointer(JSON_ARRAY, value);
+  }
+
+  void setObject(JsonObject* value) {
+    setPointer(JSON_OBJECT, value);
+  }
+
+ private:
+  // NaN-boxing needs a 64-bit double
+  typedef char double_must_have_64_bits[sizeof(double) == 8 ? 1 : -1];
+
+  static uint64_t payloadMask() {
+    return (uint64_t(1) << 48) - 1;
+  }
+
+  static uint64_t box(JsonVariantType type) {
+    return uint64_t(0xFFF0 | (type + 1)) << 48;
+  }
+
+  bool isBoxed() const {
+    return (_bits >> 52) == 0xFFF && ((_bits >> 48) & 0xF) != 0;
+  }
+
+  uintptr_t asAddress() const {
+    return static_cast<uintptr_t>(_bits & payloadMask());
+  }
+
+  void setPointer(JsonVariantType type, const void* value) {
+    _bits = box(type) |
+            static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+  }
+
+  uint64_t _bits;
+};
+#else
+// The type and the value of a JsonVariant
+class JsonVariantData {
+ public:
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+  // The length of the strings that can be copied in the content
+  static const size_t small_string_capacity = sizeof(JsonVariantContent) - 1;
+#else
+  static const size_t small_string_capacity = 0;
+#endif
+
+  JsonVariantType type() const {
+    return _type;
+  }
+
+  JsonFloat asFloat() const {
+    return _content.asFloat;
+  }
+
+  JsonUInt asInteger() const {
+    return _content.asInteger;
+  }
+
+  const char* asString() const {
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+    if (_isSmallString) return reinterpret_cast<const char*>(&_content);
+#endif
+    return _content.asString;
+  }
+
+  JsonArray* asArray() const {
+    return _content.asArray;
+  }
+
+  JsonObject* asObject() const {
+    return _content.asObject;
+  }
+
+  void setUndefined() {
+    setType(JSON_UNDEFINED, false);
+  }
+
+  void setFloat(JsonFloat value) {
+    setType(JSON_FLOAT, false);
+    _content.asFloat = value;
+  }
+
+  // type is JSON_BOOLEAN, JSON_POSITIVE_INTEGER or JSON_NEGATIVE_INTEGER
+  void setInteger(JsonVariantType type, JsonUInt value) {
+    setType(type, false);
+    _content.asInteger = value;
+  }
+
+  // type is JSON_STRING or JSON_UNPARSED
+  void setString(JsonVariantType type, const char* value) {
+    setType(type, false);
+    _content.asString = value;
+  }
+
+  // Copies the string in the content.
+  // The string must fit, see SmallString::fits().
+  void setSmallString(JsonVariantType type, const char* value) {
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+    setType(type, true);
+    strcpy(reinterpret_cast<char*>(&_content), value);
+#else
+    setString(type, value);
+#endif
+  }
+
+  bool isSmallString() const {
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+    return _isSmallString;
+#else
+    return false;
+#endif
+  }
+
+  void setArray(JsonArray* value) {
+    setType(JSON_ARRAY, false);
+    _content.asArray = value;
+  }
+
+  void setObject(JsonObject* value) {
+    setType(JSON_OBJECT, false);
+    _content.asObject = value;
+  }
+
+ private:
+  void setType(JsonVariantType type, bool isSmallString) {
+    _type = type;
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+    _isSmallString = isSmallString;
+#else
+    (void)isSmallString;
+#endif
+  }
+
+  JsonVariantType _type;
+#if ARDUINOJSON_ENABLE_SMALL_STRINGS
+  bool _isSmallString;  // fits in the padding after _type
+#endif
+  JsonVariantContent _content;
+};
+#endif
+
+// A string that is copied in the JsonVariant, instead of being referenced.
+// Only the strings that fit in JsonVariantData::small_string_capacity can be
+// copied; when ARDUINOJSON_ENABLE_SMALL_STRINGS is not set, none can.
+// CAUTION: as<const char*>() then returns a pointer in the variant, which is
+// only valid as long as the variant.
+struct SmallString {
+  SmallString(const char* s, JsonVariantType t) : value(s), type(t) {}
+
+  static bool fits(const char* s) {
+    if (!s || !JsonVariantData::small_string_capacity) return false;
+    for (size_t i = 0; i < JsonVariantData::small_string_capacity + 1; i++) {
+      if (!s[i]) return true;
+    }
+    return false;
+  }
+
+  const char* value;
+  JsonVariantType type;  // JSON_STRING or JSON_UNPARSED
+};
+}
+}
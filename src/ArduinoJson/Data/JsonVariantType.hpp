@@ -15,6 +15,12 @@ namespace Internals {
 enum JsonVariantType {
   JSON_UNDEFINED,         // JsonVariant has not been initialized
   JSON_UNPARSED,          // JsonVariant contains an unparsed string
+  // The unparsed string is classified when it's stored in the variant
+  JSON_UNPARSED_NULL,     // the unparsed string is "null"
+  JSON_UNPARSED_BOOLEAN,  // the unparsed string is "true" or "false"
+  JSON_UNPARSED_INTEGER,  // the unparsed string is an integer
+  JSON_UNPARSED_FLOAT,    // the unparsed string is a float, not an integer
+  JSON_UNPARSED_STRING,   // the unparsed string is none of the above
   JSON_STRING,            // JsonVariant stores a const char*
   JSON_BOOLEAN,           // JsonVariant stores a bool
   JSON_POSITIVE_INTEGER,  // JsonVariant stores an JsonUInt
@@ -23,5 +29,10 @@ enum JsonVariantType {
   JSON_OBJECT,            // JsonVariant stores a pointer to a JsonObject
   JSON_FLOAT              // JsonVariant stores a JsonFloat
 };
+
+// Tells whether the variant contains an unparsed string, classified or not
+inline bool isUnparsed(JsonVariantType type) {
+  return JSON_UNPARSED <= type && type <= JSON_UNPARSED_STRING;
+}
 }
 }
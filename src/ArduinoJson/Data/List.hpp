@@ -12,7 +12,8 @@ namespace ArduinoJson {
 namespace Internals {
 
 // A singly linked list of T.
-// The linked list is composed of ListNode<T>.
+// The linked list is composed of ListNode<T>; it keeps a pointer to the last
+// node and the number of nodes, so add() and size() are O(1).
 // It is derived by JsonArray and JsonObject
 template <typename T>
 class List {
@@ -27,7 +28,8 @@ class List {
   // When buffer is NULL, the List is not able to grow and success() returns
   // false. This is used to identify bad memory allocations and parsing
   // failures.
-  explicit List(JsonBuffer *buffer) : _buffer(buffer), _firstNode(NULL) {}
+  explicit List(JsonBuffer *buffer)
+      : _buffer(buffer), _firstNode(NULL), _lastNode(NULL), _size(0) {}
 
   // Returns true if the object is valid
   // Would return false in the following situation:
@@ -40,21 +42,19 @@ class List {
   // Returns the numbers of elements in the list.
   // For a JsonObject, it would return the number of key-value pairs
   size_t size() const {
-    size_t nodeCount = 0;
-    for (node_type *node = _firstNode; node; node = node->next) nodeCount++;
-    return nodeCount;
+    return _size;
   }
 
   iterator add() {
     node_type *newNode = new (_buffer) node_type();
+    if (!newNode) return end();
 
-    if (_firstNode) {
-      node_type *lastNode = _firstNode;
-      while (lastNode->next) lastNode = lastNode->next;
-      lastNode->next = newNode;
-    } else {
+    if (_lastNode)
+      _lastNode->next = newNode;
+    else
       _firstNode = newNode;
-    }
+    _lastNode = newNode;
+    _size++;
 
     return iterator(newNode);
   }
@@ -76,19 +76,41 @@ class List {
   void remove(iterator it) {
     node_type *nodeToRemove = it._node;
     if (!nodeToRemove) return;
-    if (nodeToRemove == _firstNode) {
-      _firstNode = nodeToRemove->next;
-    } else {
-      for (node_type *node = _firstNode; node; node = node->next)
-        if (node->next == nodeToRemove) node->next = nodeToRemove->next;
+
+    node_type *previousNode = NULL;
+    if (nodeToRemove != _firstNode) {
+      previousNode = _firstNode;
+      while (previousNode && previousNode->next != nodeToRemove)
+        previousNode = previousNode->next;
+      if (!previousNode) return;  // not in this list
     }
+
+    if (previousNode)
+      previousNode->next = nodeToRemove->next;
+    else
+      _firstNode = nodeToRemove->next;
+    if (nodeToRemove == _lastNode) _lastNode = previousNode;
+    _size--;
+
+    _buffer->recordOrphan(sizeof(node_type));
+    _buffer->release(nodeToRemove, sizeof(node_type));
   }
 
  protected:
+  node_type *firstNode() const {
+    return _firstNode;
+  }
+
+  node_type *lastNode() const {
+    return _lastNode;
+  }
+
   JsonBuffer *_buffer;
 
  private:
   node_type *_firstNode;
+  node_type *_lastNode;
+  size_t _size;
 };
 }
 }
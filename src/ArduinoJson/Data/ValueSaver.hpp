@@ -8,6 +8,7 @@
 #include "../JsonVariant.hpp"
 #include "../StringTraits/StringTraits.hpp"
 #include "../TypeTraits/EnableIf.hpp"
+#include "../TypeTraits/IsSame.hpp"
 
 namespace ArduinoJson {
 namespace Internals {
@@ -24,11 +25,13 @@ struct ValueSaver {
 template <typename Source>
 struct ValueSaver<
     Source, typename EnableIf<StringTraits<Source>::should_duplicate>::type> {
+  typedef typename StringTraits<Source>::duplicate_t duplicate_t;
+
   template <typename Destination>
   static bool save(JsonBuffer* buffer, Destination& dest, Source source) {
     if (!StringTraits<Source>::is_null(source)) {
-      typename StringTraits<Source>::duplicate_t dup =
-          StringTraits<Source>::duplicate(source, buffer);
+      if (saveSmallString(dest, source)) return true;
+      duplicate_t dup = StringTraits<Source>::duplicate(source, buffer);
       if (!dup) return false;
       dest = dup;
     } else {
@@ -36,6 +39,36 @@ struct ValueSaver<
     }
     return true;
   }
+
+ private:
+  // Copies the string in the variant if it fits, see SmallString
+  template <typename Destination>
+  static typename EnableIf<IsSame<Destination, JsonVariant>::value &&
+                               IsSame<duplicate_t, const char*>::value,
+                           bool>::type
+  saveSmallString(Destination& dest, Source source) {
+    char chars[JsonVariantData::small_string_capacity + 1];
+    typename StringTraits<Source>::Reader reader(source);
+    for (size_t i = 0; i < sizeof(chars); i++) {
+      chars[i] = reader.current();
+      if (!chars[i]) {
+        if (!SmallString::fits(chars)) return false;
+        dest = SmallString(chars, JSON_STRING);
+        return true;
+      }
+      reader.move();
+    }
+    return false;  // too long
+  }
+
+  // The keys and the raw strings are always duplicated
+  template <typename Destination>
+  static typename EnableIf<!IsSame<Destination, JsonVariant>::value ||
+                               !IsSame<duplicate_t, const char*>::value,
+                           bool>::type
+  saveSmallString(Destination&, Source) {
+    return false;
+  }
 };
 
 // const char*, const signed char*, const unsigned char*
@@ -4,10 +4,57 @@
 
 #pragma once
 
+#include "../Polyfills/scan.hpp"
+#include "../TypeTraits/EnableIf.hpp"
+
 namespace ArduinoJson {
 namespace Internals {
+
+// Returns a pointer to the first char of s that is neither a space nor part of
+// a comment.
+inline const char* skipSpacesAndComments(const char* s) {
+  for (;;) {
+    s = skipSpaces(s);
+    if (s[0] != '/') return s;
+
+    switch (s[1]) {
+      // C-style block comment
+      case '*':
+        // the '*' of "/*" cannot be the beginning of "*/"
+        s += 2;
+        for (;;) {
+          s = findChar(s, '*');
+          if (*s == '\0') return s;
+          s++;
+          if (*s == '/') break;
+        }
+        s++;  // skip '/'
+        break;
+
+      // C++-style line comment
+      case '/':
+        s = findChar(s + 2, '\n');
+        if (*s == '\0') return s;
+        break;
+
+      // not a comment, just a '/'
+      default:
+        return s;
+    }
+  }
+}
+
+// Contiguous inputs are scanned directly in memory
+template <typename TInput>
+typename EnableIf<TInput::is_contiguous>::type skipSpacesAndComments(
+    TInput& input) {
+  input.seek(skipSpacesAndComments(input.ptr()));
+}
+
+// Other inputs (streams, flash strings) are read one char at a time
 template <typename TInput>
-void skipSpacesAndComments(TInput& input) {
+typename EnableIf<!TInput::is_contiguous>::type skipSpacesAndComments(
+    TInput& input) {
   for (;;) {
     switch (input.current()) {
       // spaces
@@ -0,0 +1,51 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <string.h>  // for memcpy
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Writes the strings in a fixed-size buffer, which is reused for each string.
+// Strings that don't fit are reported as NULL.
+template <size_t CAPACITY>
+class FixedStringWriter {
+ public:
+  class String {
+   public:
+    String(char* buffer) : _buffer(buffer), _size(0) {}
+
+    void append(char c) {
+      if (_size < CAPACITY) _buffer[_size] = c;
+      _size++;
+    }
+
+    void append(const char* s, size_t n) {
+      if (_size + n < CAPACITY) memcpy(_buffer + _size, s, n);
+      _size += n;
+    }
+
+    const char* c_str() {
+      if (_size >= CAPACITY) return NULL;
+      _buffer[_size] = '\0';
+      return _buffer;
+    }
+
+   private:
+    char* _buffer;
+    size_t _size;
+  };
+
+  String startString() {
+    return String(_buffer);
+  }
+
+ private:
+  char _buffer[CAPACITY];
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
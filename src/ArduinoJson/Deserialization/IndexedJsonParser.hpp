@@ -0,0 +1,244 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../StringTraits/CharPointer.hpp"
+#include "JsonParserImpl.hpp"
+#include "QuotedString.hpp"
+#include "StructuralIndex.hpp"
+#include "TypedValue.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Second stage of the structural-index parser: builds the JsonArrays and
+// JsonObjects by walking the StructuralIndex instead of reading the input one
+// char at a time.
+// The semantic is exactly the same as JsonParser, which is used as a fallback
+// when the index cannot be built.
+// This internal class is not indended to be used directly.
+// Instead, use JsonBuffer.parseArray<StructuralIndexParsing>()
+template <typename TReader, typename TWriter, typename TPolicy>
+class IndexedJsonParser {
+  typedef JsonParser<TReader, TWriter, TPolicy> Fallback;
+  typedef typename RemoveReference<TWriter>::type::String String;
+
+ public:
+  IndexedJsonParser(JsonBuffer *buffer, TReader reader, TWriter writer,
+                    uint8_t nestingLimit)
+      : _buffer(buffer),
+        _reader(reader),
+        _writer(writer),
+        _nestingLimit(nestingLimit),
+        _index(NULL),
+        _cursor(0),
+        _garbage(0) {}
+
+  JsonArray &parseArray() {
+    StructuralIndex index;
+    if (!start(index)) return fallback().parseArray();
+    return parseIndexedArray();
+  }
+
+  JsonObject &parseObject() {
+    StructuralIndex index;
+    if (!start(index)) return fallback().parseObject();
+    return parseIndexedObject();
+  }
+
+  JsonVariant parseVariant() {
+    StructuralIndex index;
+    if (!start(index)) return fallback().parseVariant();
+    JsonVariant result;
+    parseAnythingTo(&result);
+    return result;
+  }
+
+ private:
+  IndexedJsonParser &operator=(const IndexedJsonParser &);  // non-copiable
+
+  Fallback fallback() const {
+    return Fallback(_buffer, _reader, _writer, _nestingLimit);
+  }
+
+  bool start(StructuralIndex &index) {
+    if (!index.build(_reader.ptr())) return false;
+    _index = &index;
+    _cursor = 0;
+    _garbage = 0;
+    return true;
+  }
+
+  // The first char of the current token
+  const char *current() const {
+    return (*_index)[_cursor];
+  }
+
+  char currentChar() const {
+    return _garbage ? _garbage : *current();
+  }
+
+  bool eat(char charToSkip) {
+    if (currentChar() != charToSkip) return false;
+    _cursor++;
+    return true;
+  }
+
+  bool parseAnythingTo(JsonVariant *destination) {
+    switch (currentChar()) {
+      case '[':
+        return parseArrayTo(destination);
+
+      case '{':
+        return parseObjectTo(destination);
+
+      default:
+        return parseStringTo(destination);
+    }
+  }
+
+  JsonArray &parseIndexedArray() {
+    if (_nestingLimit == 0) return JsonArray::invalid();
+    _nestingLimit--;
+
+    // Create an empty array
+    JsonArray &array = _buffer->createArray();
+
+    // Check opening braket
+    if (!eat('[')) return JsonArray::invalid();
+    if (!eat(']')) {
+      // Read each value
+      for (;;) {
+        JsonVariant value;
+        if (!parseAnythingTo(&value)) return JsonArray::invalid();
+        if (!array.add(value)) return JsonArray::invalid();
+
+        if (eat(']')) break;
+        if (!eat(',')) return JsonArray::invalid();
+      }
+    }
+
+    _nestingLimit++;
+    return array;
+  }
+
+  bool parseArrayTo(JsonVariant *destination) {
+    JsonArray &array = parseIndexedArray();
+    if (!array.success()) return false;
+
+    *destination = array;
+    return true;
+  }
+
+  JsonObject &parseIndexedObject() {
+    if (_nestingLimit == 0) return JsonObject::invalid();
+    _nestingLimit--;
+
+    // Create an empty object
+    JsonObject &object = _buffer->createObject();
+
+    // Check opening brace
+    if (!eat('{')) return JsonObject::invalid();
+    if (!eat('}')) {
+      // Read each key value pair
+      for (;;) {
+        String str = _writer.startString();
+        const char *key = parseString(str);
+        if (!key) return JsonObject::invalid();
+        if (!eat(':')) return JsonObject::invalid();
+
+        JsonVariant value;
+        if (!parseAnythingTo(&value)) return JsonObject::invalid();
+        if (!addMember<TPolicy>(object, key, value))
+          return JsonObject::invalid();
+
+        if (eat('}')) break;
+        if (!eat(',')) return JsonObject::invalid();
+      }
+    }
+
+    _nestingLimit++;
+    return object;
+  }
+
+  bool parseObjectTo(JsonVariant *destination) {
+    JsonObject &object = parseIndexedObject();
+    if (!object.success()) return false;
+
+    *destination = object;
+    return true;
+  }
+
+  const char *parseString(String &str) {
+    if (!_garbage) {
+      const char *s = current();
+      if (*s == '"') {
+        CharPointerTraits<char>::Reader reader(s + 1);
+        readQuotedString(reader, str, '"');
+        _cursor++;
+      } else {
+        const char *end = s;
+        while (canBeInNonQuotedString(*end)) end++;
+        if (end != s) {
+          _cursor++;
+          // The index only knows about the first char of a token, so we
+          // remember where JsonParser would have stopped.
+          // This must be read before writing, as the string may be in place.
+          if (!isTokenBoundary(*end)) _garbage = *end;
+          str.append(s, static_cast<size_t>(end - s));
+        }
+      }
+    }
+
+    return str.c_str();
+  }
+
+  bool parseStringTo(JsonVariant *destination) {
+    bool hasQuotes = !_garbage && *current() == '"';
+    String str = _writer.startString();
+    const char *value = parseString(str);
+    if (value == NULL) return false;
+    if (hasQuotes) {
+      storeString(destination, str, value, JSON_STRING);
+    } else if (TPolicy::eager_typing && parseTypedValue(value, destination)) {
+      // the text is not needed anymore
+      str.discard();
+    } else {
+      storeString(destination, str, value, JSON_UNPARSED);
+    }
+    return true;
+  }
+
+  static bool isTokenBoundary(char c) {
+    switch (c) {
+      case '\0':
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+      case '"':
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  JsonBuffer *_buffer;
+  TReader _reader;
+  TWriter _writer;
+  uint8_t _nestingLimit;
+
+  const StructuralIndex *_index;
+  size_t _cursor;
+  char _garbage;  // the char where the last non-quoted string stopped
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
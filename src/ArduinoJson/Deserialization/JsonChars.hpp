@@ -0,0 +1,25 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+namespace ArduinoJson {
+namespace Internals {
+
+// The lexical rules shared by all the parsers
+
+inline bool isBetween(char c, char min, char max) {
+  return min <= c && c <= max;
+}
+
+inline bool canBeInNonQuotedString(char c) {
+  return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+         isBetween(c, 'A', 'Z') || c == '+' || c == '-' || c == '.';
+}
+
+inline bool isQuote(char c) {
+  return c == '\'' || c == '\"';
+}
+}  // namespace Internals
+}  // namespace ArduinoJson
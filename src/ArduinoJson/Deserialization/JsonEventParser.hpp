@@ -0,0 +1,173 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <string.h>  // for strcmp
+
+#include "../Polyfills/isFloat.hpp"
+#include "../StringTraits/StringTraits.hpp"
+#include "../TypeTraits/IsConst.hpp"
+#include "../TypeTraits/RemoveReference.hpp"
+#include "Comments.hpp"
+#include "FixedStringWriter.hpp"
+#include "JsonChars.hpp"
+#include "QuotedString.hpp"
+#include "StringWriter.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Parse JSON string and calls the handler for each token, without building
+// any JsonArray or JsonObject.
+// This internal class is not indended to be used directly.
+// Instead, use parseJsonEvents()
+template <typename TReader, typename TWriter, typename THandler>
+class JsonEventParser {
+ public:
+  JsonEventParser(TReader reader, TWriter writer, THandler &handler,
+                  uint8_t nestingLimit)
+      : _reader(reader),
+        _writer(writer),
+        _handler(handler),
+        _nestingLimit(nestingLimit) {}
+
+  bool parse() {
+    skipSpacesAndComments(_reader);
+
+    switch (_reader.current()) {
+      case '[':
+        return parseArray();
+
+      case '{':
+        return parseObject();
+
+      default:
+        return parseValue();
+    }
+  }
+
+ private:
+  JsonEventParser &operator=(const JsonEventParser &);  // non-copiable
+
+  bool eat(char charToSkip) {
+    skipSpacesAndComments(_reader);
+    if (_reader.current() != charToSkip) return false;
+    _reader.move();
+    return true;
+  }
+
+  bool parseArray() {
+    if (_nestingLimit == 0) return false;
+    _nestingLimit--;
+
+    _reader.move();  // skip '['
+    if (!_handler.startArray()) return false;
+
+    if (!eat(']')) {
+      for (;;) {
+        if (!parse()) return false;
+        if (eat(']')) break;
+        if (!eat(',')) return false;
+      }
+    }
+
+    _nestingLimit++;
+    return _handler.endArray();
+  }
+
+  bool parseObject() {
+    if (_nestingLimit == 0) return false;
+    _nestingLimit--;
+
+    _reader.move();  // skip '{'
+    if (!_handler.startObject()) return false;
+
+    if (!eat('}')) {
+      for (;;) {
+        const char *key = parseString();
+        if (!key) return false;
+        if (!_handler.key(key)) return false;
+        if (!eat(':')) return false;
+
+        if (!parse()) return false;
+
+        if (eat('}')) break;
+        if (!eat(',')) return false;
+      }
+    }
+
+    _nestingLimit++;
+    return _handler.endObject();
+  }
+
+  bool parseValue() {
+    bool hasQuotes = isQuote(_reader.current());
+    const char *value = parseString();
+    if (value == NULL) return false;
+    if (hasQuotes) return _handler.string(value);
+    if (!strcmp(value, "true")) return _handler.boolean(true);
+    if (!strcmp(value, "false")) return _handler.boolean(false);
+    if (!strcmp(value, "null")) return _handler.null();
+    if (isFloat(value)) return _handler.number(value);
+    return _handler.string(value);
+  }
+
+  const char *parseString() {
+    typename RemoveReference<TWriter>::type::String str =
+        _writer.startString();
+
+    skipSpacesAndComments(_reader);
+    char c = _reader.current();
+
+    if (isQuote(c)) {  // quotes
+      _reader.move();
+      readQuotedString(_reader, str, c);
+    } else {  // no quotes
+      for (;;) {
+        if (!canBeInNonQuotedString(c)) break;
+        _reader.move();
+        str.append(c);
+        c = _reader.current();
+      }
+    }
+
+    return str.c_str();
+  }
+
+  TReader _reader;
+  TWriter _writer;
+  THandler &_handler;
+  uint8_t _nestingLimit;
+};
+
+// Read-only inputs: the strings are copied in a buffer on the stack
+template <typename TString, typename THandler, typename Enable = void>
+struct JsonEventParserBuilder {
+  typedef typename StringTraits<TString>::Reader TReader;
+  typedef FixedStringWriter<ARDUINOJSON_EVENT_STRING_SIZE> TWriter;
+
+  static bool parse(TString &json, THandler &handler, uint8_t nestingLimit) {
+    TWriter writer;
+    return JsonEventParser<TReader, TWriter &, THandler>(
+               TReader(json), writer, handler, nestingLimit)
+        .parse();
+  }
+};
+
+// Writable inputs: the strings are unescaped in place
+template <typename TChar, typename THandler>
+struct JsonEventParserBuilder<TChar *, THandler,
+                              typename EnableIf<!IsConst<TChar>::value>::type> {
+  typedef typename StringTraits<TChar *>::Reader TReader;
+  typedef StringWriter<TChar> TWriter;
+
+  static bool parse(TChar *json, THandler &handler, uint8_t nestingLimit) {
+    return JsonEventParser<TReader, TWriter, THandler>(
+               TReader(json), TWriter(json), handler, nestingLimit)
+        .parse();
+  }
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
@@ -6,31 +6,47 @@
 
 #include "../JsonBuffer.hpp"
 #include "../JsonVariant.hpp"
+#include "../ParsingPolicy.hpp"
 #include "../TypeTraits/IsConst.hpp"
+#include "JsonChars.hpp"
+#include "NoFilter.hpp"
 #include "StringWriter.hpp"
 
 namespace ArduinoJson {
 namespace Internals {
 
+template <typename TReader, typename TWriter, typename TPolicy>
+class IndexedJsonParser;
+
 // Parse JSON string to create JsonArrays and JsonObjects
+// The values rejected by the filter are skipped without being allocated.
 // This internal class is not indended to be used directly.
 // Instead, use JsonBuffer.parseArray() or .parseObject()
-template <typename TReader, typename TWriter>
+template <typename TReader, typename TWriter, typename TPolicy = DefaultParsing,
+          typename TFilter = NoFilter>
 class JsonParser {
+  typedef typename RemoveReference<TWriter>::type::String String;
+
  public:
   JsonParser(JsonBuffer *buffer, TReader reader, TWriter writer,
-             uint8_t nestingLimit)
+             uint8_t nestingLimit, TFilter filter = TFilter())
       : _buffer(buffer),
         _reader(reader),
         _writer(writer),
-        _nestingLimit(nestingLimit) {}
+        _nestingLimit(nestingLimit),
+        _filter(filter) {}
+
+  JsonArray &parseArray() {
+    return parseArray(_filter);
+  }
 
-  JsonArray &parseArray();
-  JsonObject &parseObject();
+  JsonObject &parseObject() {
+    return parseObject(_filter);
+  }
 
   JsonVariant parseVariant() {
     JsonVariant result;
-    parseAnythingTo(&result);
+    parseAnythingTo(&result, _filter);
     return result;
   }
 
@@ -42,54 +58,81 @@ class JsonParser {
     return eat(_reader, charToSkip);
   }
 
-  const char *parseString();
-  bool parseAnythingTo(JsonVariant *destination);
-
-  inline bool parseArrayTo(JsonVariant *destination);
-  inline bool parseObjectTo(JsonVariant *destination);
-  inline bool parseStringTo(JsonVariant *destination);
+  JsonArray &parseArray(const TFilter &filter);
+  JsonObject &parseObject(const TFilter &filter);
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
+  const char *parseString(String &str);
+  bool parseAnythingTo(JsonVariant *destination, const TFilter &filter);
 
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z') || c == '+' || c == '-' || c == '.';
-  }
+  inline bool parseArrayTo(JsonVariant *destination, const TFilter &filter);
+  inline bool parseObjectTo(JsonVariant *destination, const TFilter &filter);
+  inline bool parseStringTo(JsonVariant *destination);
 
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
+  inline bool accepts(const TFilter &filter);
 
   JsonBuffer *_buffer;
   TReader _reader;
   TWriter _writer;
   uint8_t _nestingLimit;
+  TFilter _filter;
 };
 
-template <typename TJsonBuffer, typename TString, typename Enable = void>
+// Selects the parser for the specified policy: the structural index requires
+// the whole input to be in memory.
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename Enable = void>
+struct JsonParserSelector {
+  typedef JsonParser<TReader, TWriter, TPolicy> type;
+};
+
+template <typename TReader, typename TWriter, typename TPolicy>
+struct JsonParserSelector<
+    TReader, TWriter, TPolicy,
+    typename EnableIf<TPolicy::use_structural_index &&
+                      TReader::is_contiguous>::type> {
+  typedef IndexedJsonParser<TReader, TWriter, TPolicy> type;
+};
+
+template <typename TJsonBuffer, typename TString,
+          typename TPolicy = DefaultParsing, typename Enable = void>
 struct JsonParserBuilder {
-  typedef typename StringTraits<TString>::Reader InputReader;
-  typedef JsonParser<InputReader, TJsonBuffer &> TParser;
+  typedef typename StringTraits<TString>::Reader TReader;
+  typedef TJsonBuffer &TWriter;
+  typedef typename JsonParserSelector<TReader, TWriter, TPolicy>::type TParser;
 
   static TParser makeParser(TJsonBuffer *buffer, TString &json,
                             uint8_t nestingLimit) {
-    return TParser(buffer, InputReader(json), *buffer, nestingLimit);
+    return TParser(buffer, TReader(json), *buffer, nestingLimit);
+  }
+
+  template <typename TFilter>
+  static JsonParser<TReader, TWriter, TPolicy, TFilter> makeParser(
+      TJsonBuffer *buffer, TString &json, uint8_t nestingLimit,
+      const TFilter &filter) {
+    return JsonParser<TReader, TWriter, TPolicy, TFilter>(
+        buffer, TReader(json), *buffer, nestingLimit, filter);
   }
 };
 
-template <typename TJsonBuffer, typename TChar>
-struct JsonParserBuilder<TJsonBuffer, TChar *,
+template <typename TJsonBuffer, typename TChar, typename TPolicy>
+struct JsonParserBuilder<TJsonBuffer, TChar *, TPolicy,
                          typename EnableIf<!IsConst<TChar>::value>::type> {
   typedef typename StringTraits<TChar *>::Reader TReader;
   typedef StringWriter<TChar> TWriter;
-  typedef JsonParser<TReader, TWriter> TParser;
+  typedef typename JsonParserSelector<TReader, TWriter, TPolicy>::type TParser;
 
   static TParser makeParser(TJsonBuffer *buffer, TChar *json,
                             uint8_t nestingLimit) {
     return TParser(buffer, TReader(json), TWriter(json), nestingLimit);
   }
+
+  template <typename TFilter>
+  static JsonParser<TReader, TWriter, TPolicy, TFilter> makeParser(
+      TJsonBuffer *buffer, TChar *json, uint8_t nestingLimit,
+      const TFilter &filter) {
+    return JsonParser<TReader, TWriter, TPolicy, TFilter>(
+        buffer, TReader(json), TWriter(json), nestingLimit, filter);
+  }
 };
 
 template <typename TJsonBuffer, typename TString>
@@ -98,5 +141,22 @@ inline typename JsonParserBuilder<TJsonBuffer, TString>::TParser makeParser(
   return JsonParserBuilder<TJsonBuffer, TString>::makeParser(buffer, json,
                                                              nestingLimit);
 }
+
+template <typename TPolicy, typename TJsonBuffer, typename TString>
+inline typename JsonParserBuilder<TJsonBuffer, TString, TPolicy>::TParser
+makeParser(TJsonBuffer *buffer, TString &json, uint8_t nestingLimit) {
+  return JsonParserBuilder<TJsonBuffer, TString, TPolicy>::makeParser(
+      buffer, json, nestingLimit);
+}
+
+template <typename TJsonBuffer, typename TString, typename TFilter>
+inline JsonParser<typename JsonParserBuilder<TJsonBuffer, TString>::TReader,
+                  typename JsonParserBuilder<TJsonBuffer, TString>::TWriter,
+                  DefaultParsing, TFilter>
+makeParser(TJsonBuffer *buffer, TString &json, uint8_t nestingLimit,
+           const TFilter &filter) {
+  return JsonParserBuilder<TJsonBuffer, TString>::makeParser(
+      buffer, json, nestingLimit, filter);
+}
 }  // namespace Internals
 }  // namespace ArduinoJson
@@ -6,9 +6,46 @@
 
 #include "Comments.hpp"
 #include "JsonParser.hpp"
+#include "QuotedString.hpp"
+#include "SkipValue.hpp"
+#include "TypedValue.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+// Adds a member to an object being parsed.
+// The key is already in the JsonBuffer; it's searched in the object only if
+// the policy says so.
+template <typename TPolicy>
+inline bool addMember(JsonObject &object, const char *key,
+                      const JsonVariant &value) {
+  if (TPolicy::check_duplicate_keys) return object.set(key, value);
+  JsonObject::iterator it = object.addNode(key);
+  if (it == object.end()) return false;
+  it->value = value;
+  return true;
+}
+
+// Stores a string that was just parsed, type is JSON_STRING or JSON_UNPARSED.
+// A small string is copied in the variant, so its text is released.
+template <typename TString>
+inline void storeString(JsonVariant *destination, TString &str,
+                        const char *value, JsonVariantType type) {
+  if (SmallString::fits(value)) {
+    *destination = SmallString(value, type);
+    str.discard();
+  } else if (type == JSON_STRING) {
+    *destination = value;
+  } else {
+    *destination = RawJson(value);
+  }
+}
+}
+}
 
-template <typename TReader, typename TWriter>
-inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::eat(
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy, TFilter>::eat(
     TReader &reader, char charToSkip) {
   skipSpacesAndComments(reader);
   if (reader.current() != charToSkip) return false;
@@ -16,32 +53,35 @@ inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::eat(
   return true;
 }
 
-template <typename TReader, typename TWriter>
-inline bool
-ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseAnythingTo(
-    JsonVariant *destination) {
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy,
+                                              TFilter>::parseAnythingTo(
+    JsonVariant *destination, const TFilter &filter) {
   skipSpacesAndComments(_reader);
 
   switch (_reader.current()) {
     case '[':
-      return parseArrayTo(destination);
+      return parseArrayTo(destination, filter);
 
     case '{':
-      return parseObjectTo(destination);
+      return parseObjectTo(destination, filter);
 
     default:
       return parseStringTo(destination);
   }
 }
 
-template <typename TReader, typename TWriter>
-inline ArduinoJson::JsonArray &
-ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseArray() {
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline ArduinoJson::JsonArray &ArduinoJson::Internals::JsonParser<
+    TReader, TWriter, TPolicy, TFilter>::parseArray(const TFilter &filter) {
   if (_nestingLimit == 0) return JsonArray::invalid();
   _nestingLimit--;
 
   // Create an empty array
   JsonArray &array = _buffer->createArray();
+  TFilter elementFilter = filter.element();
 
   // Check opening braket
   if (!eat('[')) goto ERROR_MISSING_BRACKET;
@@ -50,9 +90,13 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseArray() {
   // Read each value
   for (;;) {
     // 1 - Parse value
-    JsonVariant value;
-    if (!parseAnythingTo(&value)) goto ERROR_INVALID_VALUE;
-    if (!array.add(value)) goto ERROR_NO_MEMORY;
+    if (accepts(elementFilter)) {
+      JsonVariant value;
+      if (!parseAnythingTo(&value, elementFilter)) goto ERROR_INVALID_VALUE;
+      if (!array.add(value)) goto ERROR_NO_MEMORY;
+    } else {
+      if (!skipValue(_reader, _nestingLimit)) goto ERROR_INVALID_VALUE;
+    }
 
     // 2 - More values?
     if (eat(']')) goto SUCCES_NON_EMPTY_ARRAY;
@@ -71,19 +115,22 @@ ERROR_NO_MEMORY:
   return JsonArray::invalid();
 }
 
-template <typename TReader, typename TWriter>
-inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseArrayTo(
-    JsonVariant *destination) {
-  JsonArray &array = parseArray();
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy,
+                                              TFilter>::parseArrayTo(
+    JsonVariant *destination, const TFilter &filter) {
+  JsonArray &array = parseArray(filter);
   if (!array.success()) return false;
 
   *destination = array;
   return true;
 }
 
-template <typename TReader, typename TWriter>
-inline ArduinoJson::JsonObject &
-ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseObject() {
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline ArduinoJson::JsonObject &ArduinoJson::Internals::JsonParser<
+    TReader, TWriter, TPolicy, TFilter>::parseObject(const TFilter &filter) {
   if (_nestingLimit == 0) return JsonObject::invalid();
   _nestingLimit--;
 
@@ -97,14 +144,22 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseObject() {
   // Read each key value pair
   for (;;) {
     // 1 - Parse key
-    const char *key = parseString();
+    String str = _writer.startString();
+    const char *key = parseString(str);
     if (!key) goto ERROR_INVALID_KEY;
     if (!eat(':')) goto ERROR_MISSING_COLON;
 
     // 2 - Parse value
-    JsonVariant value;
-    if (!parseAnythingTo(&value)) goto ERROR_INVALID_VALUE;
-    if (!object.set(key, value)) goto ERROR_NO_MEMORY;
+    TFilter memberFilter = filter[key];
+    if (accepts(memberFilter)) {
+      JsonVariant value;
+      if (!parseAnythingTo(&value, memberFilter)) goto ERROR_INVALID_VALUE;
+      if (!addMember<TPolicy>(object, key, value)) goto ERROR_NO_MEMORY;
+    } else {
+      // nothing was allocated since the key, so we can release it
+      str.discard();
+      if (!skipValue(_reader, _nestingLimit)) goto ERROR_INVALID_VALUE;
+    }
 
     // 3 - More keys/values?
     if (eat('}')) goto SUCCESS_NON_EMPTY_OBJECT;
@@ -125,43 +180,28 @@ ERROR_NO_MEMORY:
   return JsonObject::invalid();
 }
 
-template <typename TReader, typename TWriter>
-inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseObjectTo(
-    JsonVariant *destination) {
-  JsonObject &object = parseObject();
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy,
+                                              TFilter>::parseObjectTo(
+    JsonVariant *destination, const TFilter &filter) {
+  JsonObject &object = parseObject(filter);
   if (!object.success()) return false;
 
   *destination = object;
   return true;
 }
 
-template <typename TReader, typename TWriter>
-inline const char *
-ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseString() {
-  typename RemoveReference<TWriter>::type::String str = _writer.startString();
-
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline const char *ArduinoJson::Internals::JsonParser<
+    TReader, TWriter, TPolicy, TFilter>::parseString(String &str) {
   skipSpacesAndComments(_reader);
   char c = _reader.current();
 
   if (isQuote(c)) {  // quotes
     _reader.move();
-    char stopChar = c;
-    for (;;) {
-      c = _reader.current();
-      if (c == '\0') break;
-      _reader.move();
-
-      if (c == stopChar) break;
-
-      if (c == '\\') {
-        // replace char
-        c = Encoding::unescapeChar(_reader.current());
-        if (c == '\0') break;
-        _reader.move();
-      }
-
-      str.append(c);
-    }
+    readQuotedString(_reader, str, c);
   } else {  // no quotes
     for (;;) {
       if (!canBeInNonQuotedString(c)) break;
@@ -174,16 +214,42 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseString() {
   return str.c_str();
 }
 
-template <typename TReader, typename TWriter>
-inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseStringTo(
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy,
+                                              TFilter>::parseStringTo(
     JsonVariant *destination) {
   bool hasQuotes = isQuote(_reader.current());
-  const char *value = parseString();
+  String str = _writer.startString();
+  const char *value = parseString(str);
   if (value == NULL) return false;
   if (hasQuotes) {
-    *destination = value;
+    storeString(destination, str, value, JSON_STRING);
+  } else if (TPolicy::eager_typing && parseTypedValue(value, destination)) {
+    // the text is not needed anymore
+    str.discard();
   } else {
-    *destination = RawJson(value);
+    storeString(destination, str, value, JSON_UNPARSED);
   }
   return true;
 }
+
+// Tells if the filter keeps the next value, depending on its type
+template <typename TReader, typename TWriter, typename TPolicy,
+          typename TFilter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter, TPolicy, TFilter>::accepts(
+    const TFilter &filter) {
+  skipSpacesAndComments(_reader);
+
+  switch (_reader.current()) {
+    case '[':
+      return filter.allowArray();
+
+    case '{':
+      return filter.allowObject();
+
+    default:
+      return filter.allowValue();
+  }
+}
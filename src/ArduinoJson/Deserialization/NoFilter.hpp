@@ -0,0 +1,34 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+namespace ArduinoJson {
+namespace Internals {
+
+// The filter of JsonParser when none is specified: it keeps everything, and
+// compiles to nothing.
+struct NoFilter {
+  bool allowArray() const {
+    return true;
+  }
+
+  bool allowObject() const {
+    return true;
+  }
+
+  bool allowValue() const {
+    return true;
+  }
+
+  NoFilter operator[](const char *) const {
+    return *this;
+  }
+
+  NoFilter element() const {
+    return *this;
+  }
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
@@ -0,0 +1,67 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include "../Data/Encoding.hpp"
+#include "../Polyfills/scan.hpp"
+#include "../TypeTraits/EnableIf.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Reads the content of a quoted string, the opening quote being already
+// consumed, and appends the unescaped chars to str.
+// Stops after the closing quote, or at the terminator.
+//
+// Contiguous inputs are copied in bulk between escape sequences
+template <typename TInput, typename TString>
+typename EnableIf<TInput::is_contiguous>::type readQuotedString(
+    TInput& input, TString& str, char stopChar) {
+  const char* s = input.ptr();
+  for (;;) {
+    const char* end = findChar(s, stopChar, '\\');
+    str.append(s, static_cast<size_t>(end - s));
+    s = end;
+
+    if (*s == '\0') break;
+    s++;
+
+    if (*end == stopChar) break;
+
+    // replace char
+    char c = Encoding::unescapeChar(*s);
+    if (c == '\0') break;
+    s++;
+
+    str.append(c);
+  }
+  input.seek(s);
+}
+
+// Other inputs are read one char at a time
+template <typename TInput, typename TString>
+typename EnableIf<!TInput::is_contiguous>::type readQuotedString(
+    TInput& input, TString& str, char stopChar) {
+  for (;;) {
+    char c = input.current();
+    if (c == '\0') break;
+    input.move();
+
+    if (c == stopChar) break;
+
+    if (c == '\\') {
+      // replace char
+      c = Encoding::unescapeChar(input.current());
+      if (c == '\0') break;
+      input.move();
+    }
+
+    str.append(c);
+  }
+}
+}  // namespace Internals
+}  // namespace ArduinoJson
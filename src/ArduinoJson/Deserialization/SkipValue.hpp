@@ -0,0 +1,159 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t
+
+#include "../Polyfills/scan.hpp"
+#include "../TypeTraits/EnableIf.hpp"
+#include "Comments.hpp"
+#include "JsonChars.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Reads a value with the same rules as JsonParser, but doesn't store anything:
+// neither the JsonBuffer nor the writer are used.
+
+// Returns a pointer after the string that starts at s.
+// An unterminated string stops at the terminator, like in JsonParser.
+inline const char *skipString(const char *s) {
+  s = skipSpacesAndComments(s);
+  char stopChar = *s;
+
+  if (!isQuote(stopChar)) {
+    while (canBeInNonQuotedString(*s)) s++;
+    return s;
+  }
+
+  s++;
+  for (;;) {
+    s = findChar(s, stopChar, '\\');
+    if (*s == '\0') return s;
+    if (*s++ == stopChar) return s;
+    // escape sequence
+    if (*s == '\0') return s;
+    s++;
+  }
+}
+
+// Returns a pointer after the value that starts at s, or NULL if the value is
+// invalid or too deep.
+// Only the strings, spaces and comments are read char by char; they are
+// scanned 16 or 32 bytes at a time when ARDUINOJSON_ENABLE_SIMD is set.
+inline const char *skipValue(const char *s, uint8_t nestingLimit) {
+  s = skipSpacesAndComments(s);
+
+  switch (*s) {
+    case '[':
+      if (nestingLimit == 0) return NULL;
+      s = skipSpacesAndComments(s + 1);
+      if (*s == ']') return s + 1;
+      for (;;) {
+        s = skipValue(s, uint8_t(nestingLimit - 1));
+        if (!s) return NULL;
+        s = skipSpacesAndComments(s);
+        if (*s == ']') return s + 1;
+        if (*s != ',') return NULL;
+        s++;
+      }
+
+    case '{':
+      if (nestingLimit == 0) return NULL;
+      s = skipSpacesAndComments(s + 1);
+      if (*s == '}') return s + 1;
+      for (;;) {
+        s = skipSpacesAndComments(skipString(s));
+        if (*s != ':') return NULL;
+        s = skipValue(s + 1, uint8_t(nestingLimit - 1));
+        if (!s) return NULL;
+        s = skipSpacesAndComments(s);
+        if (*s == '}') return s + 1;
+        if (*s != ',') return NULL;
+        s++;
+      }
+
+    default:
+      return skipString(s);
+  }
+}
+
+// Contiguous inputs are skipped directly in memory
+template <typename TReader>
+typename EnableIf<TReader::is_contiguous, bool>::type skipValue(
+    TReader &reader, uint8_t nestingLimit) {
+  const char *end = skipValue(reader.ptr(), nestingLimit);
+  if (!end) return false;
+  reader.seek(end);
+  return true;
+}
+
+template <typename TReader>
+bool skipChar(TReader &reader, char c) {
+  skipSpacesAndComments(reader);
+  if (reader.current() != c) return false;
+  reader.move();
+  return true;
+}
+
+template <typename TReader>
+void skipString(TReader &reader) {
+  skipSpacesAndComments(reader);
+  char stopChar = reader.current();
+
+  if (!isQuote(stopChar)) {
+    while (canBeInNonQuotedString(reader.current())) reader.move();
+    return;
+  }
+
+  reader.move();
+  for (;;) {
+    char c = reader.current();
+    if (c == '\0') return;
+    reader.move();
+    if (c == stopChar) return;
+    if (c == '\\') {
+      if (reader.current() == '\0') return;
+      reader.move();
+    }
+  }
+}
+
+// Other inputs (streams, flash strings) are read one char at a time
+template <typename TReader>
+typename EnableIf<!TReader::is_contiguous, bool>::type skipValue(
+    TReader &reader, uint8_t nestingLimit) {
+  skipSpacesAndComments(reader);
+
+  switch (reader.current()) {
+    case '[':
+      if (nestingLimit == 0) return false;
+      reader.move();
+      if (skipChar(reader, ']')) return true;
+      for (;;) {
+        if (!skipValue(reader, uint8_t(nestingLimit - 1))) return false;
+        if (skipChar(reader, ']')) return true;
+        if (!skipChar(reader, ',')) return false;
+      }
+
+    case '{':
+      if (nestingLimit == 0) return false;
+      reader.move();
+      if (skipChar(reader, '}')) return true;
+      for (;;) {
+        skipString(reader);
+        if (!skipChar(reader, ':')) return false;
+        if (!skipValue(reader, uint8_t(nestingLimit - 1))) return false;
+        if (skipChar(reader, '}')) return true;
+        if (!skipChar(reader, ',')) return false;
+      }
+
+    default:
+      skipString(reader);
+      return true;
+  }
+}
+}  // namespace Internals
+}  // namespace ArduinoJson
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string.h>  // for memmove
+
 namespace ArduinoJson {
 namespace Internals {
 
@@ -18,11 +20,23 @@ class StringWriter {
       *(*_writePtr)++ = TChar(c);
     }
 
+    // The source may overlap the destination, as the string is unescaped in
+    // place
+    void append(const char* s, size_t n) {
+      memmove(*_writePtr, s, n);
+      *_writePtr += n;
+    }
+
     const char* c_str() const {
       *(*_writePtr)++ = 0;
       return reinterpret_cast<const char*>(_startPtr);
     }
 
+    // Gives the space back to the following strings
+    void discard() {
+      *_writePtr = _startPtr;
+    }
+
    private:
     TChar** _writePtr;
     TChar* _startPtr;
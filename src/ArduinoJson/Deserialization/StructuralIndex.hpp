@@ -0,0 +1,241 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>
+#include <stdlib.h>  // for realloc() and free()
+
+#include "../Configuration.hpp"
+#include "../Data/NonCopyable.hpp"
+#include "../Polyfills/scan.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// The classes of the chars in a block of 64 bytes, one bit per byte.
+struct JsonCharClasses {
+  uint64_t quotes;
+  uint64_t backslashes;
+  uint64_t operators;  // {}[]:,
+  uint64_t spaces;
+  uint64_t unsupported;  // the comments and the single quotes
+  uint64_t terminators;
+
+#if ARDUINOJSON_ENABLE_SIMD
+  // p must be aligned on 64 bytes
+  void classify(const char* p) {
+    quotes = backslashes = operators = spaces = unsupported = terminators = 0;
+    for (unsigned i = 0; i < 64; i += Simd::block_size) {
+      Simd::block_type b = Simd::load(p + i);
+      quotes |= uint64_t(Simd::equals(b, '"')) << i;
+      backslashes |= uint64_t(Simd::equals(b, '\\')) << i;
+      operators |= uint64_t(Simd::equals(b, '{') | Simd::equals(b, '}') |
+                            Simd::equals(b, '[') | Simd::equals(b, ']') |
+                            Simd::equals(b, ':') | Simd::equals(b, ','))
+                   << i;
+      spaces |= uint64_t(Simd::equals(b, ' ') | Simd::equals(b, '\t') |
+                         Simd::equals(b, '\r') | Simd::equals(b, '\n'))
+                << i;
+      unsupported |= uint64_t(Simd::equals(b, '/') | Simd::equals(b, '\''))
+                     << i;
+      terminators |= uint64_t(Simd::equals(b, '\0')) << i;
+    }
+  }
+#else
+  // stops at the terminator
+  void classify(const char* p) {
+    quotes = backslashes = operators = spaces = unsupported = terminators = 0;
+    for (unsigned i = 0; i < 64; i++) {
+      uint64_t bit = uint64_t(1) << i;
+      switch (p[i]) {
+        case '"':
+          quotes |= bit;
+          break;
+        case '\\':
+          backslashes |= bit;
+          break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+          operators |= bit;
+          break;
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          spaces |= bit;
+          break;
+        case '/':
+        case '\'':
+          unsupported |= bit;
+          break;
+        case '\0':
+          terminators |= bit;
+          return;
+      }
+    }
+  }
+#endif
+};
+
+// The positions of the structural chars of a JSON document:
+// - the operators {}[]:, outside of the strings,
+// - the opening quotes of the strings,
+// - the first char of the other tokens (numbers, literals, non-quoted strings)
+//
+// The input is processed in blocks of 64 bytes, and the positions are
+// extracted from bitmasks, as described in "Parsing Gigabytes of JSON per
+// Second" by Geoff Langdale and Daniel Lemire.
+class StructuralIndex : NonCopyable {
+ public:
+  StructuralIndex()
+      : _json(NULL), _end(NULL), _positions(NULL), _size(0), _capacity(0) {}
+
+  ~StructuralIndex() {
+    free(_positions);
+  }
+
+  // Returns false if the input contains comments or single quotes, that are
+  // only supported by the recursive-descent parser, or if the memory
+  // allocation fails.
+  bool build(const char* json) {
+    _json = json;
+    _size = 0;
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(json);
+#if ARDUINOJSON_ENABLE_SIMD
+    // aligned loads never cross a page boundary (see Simd::scan())
+    uintptr_t offset = address & 63;
+#else
+    uintptr_t offset = 0;
+#endif
+    const char* block = reinterpret_cast<const char*>(address - offset);
+    uint64_t valid = ~uint64_t(0) << offset;
+
+    uint64_t inString = 0;   // all ones if the previous block ended in a string
+    uint64_t escaped = 0;    // 1 if the first char of this block is escaped
+    uint64_t inToken = 0;    // 1 if the previous block ended in a token
+
+    for (;;) {
+      if (!reserve(_size + 64)) return false;
+
+      JsonCharClasses c;
+      c.classify(block);
+
+      uint64_t terminator = c.terminators & valid;
+      if (terminator) valid &= (terminator & (0 - terminator)) - 1;
+
+      uint64_t quotes = c.quotes & ~findEscapedChars(c.backslashes & valid,
+                                                     escaped) &
+                        valid;
+      uint64_t strings = prefixXor(quotes) ^ inString;
+      inString = 0 - (strings >> 63);
+
+      uint64_t outside = ~strings & valid;
+      if (c.unsupported & outside) return false;
+
+      uint64_t tokens = ~(c.operators | c.spaces | quotes) & outside;
+      uint64_t structurals = (c.operators & outside) | (quotes & strings) |
+                             (tokens & ~((tokens << 1) | inToken));
+      inToken = tokens >> 63;
+
+      const uint32_t base = static_cast<uint32_t>(block - json);
+      while (structurals) {
+        _positions[_size++] = base + countTrailingZeros(structurals);
+        structurals &= structurals - 1;
+      }
+
+      if (terminator) {
+        _end = block + countTrailingZeros(terminator);
+        return true;
+      }
+
+      block += 64;
+      valid = ~uint64_t(0);
+
+      // positions are stored on 32 bits
+      if (static_cast<uint64_t>(block - json) > 0xFFFFFFC0) return false;
+    }
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  // Returns a pointer to the specified structural char, or to the terminator
+  // if index is out of range.
+  const char* operator[](size_t index) const {
+    return index < _size ? _json + _positions[index] : _end;
+  }
+
+ private:
+  bool reserve(size_t capacity) {
+    if (capacity <= _capacity) return true;
+    size_t newCapacity = _capacity ? _capacity * 2 : 256;
+    void* newPositions =
+        realloc(_positions, newCapacity * sizeof(*_positions));
+    if (!newPositions) return false;
+    _positions = static_cast<uint32_t*>(newPositions);
+    _capacity = newCapacity;
+    return true;
+  }
+
+  // Returns the chars that are preceded by an odd number of backslashes.
+  // Backslashes are rare, so we simply loop on them.
+  static uint64_t findEscapedChars(uint64_t backslashes, uint64_t& carry) {
+    uint64_t result = carry;
+    backslashes &= ~carry;
+    carry = 0;
+    while (backslashes) {
+      uint64_t backslash = backslashes & (0 - backslashes);
+      uint64_t next = backslash << 1;
+      if (next) {
+        result |= next;
+        backslashes &= ~next;  // an escaped backslash escapes nothing
+      } else {
+        carry = 1;
+      }
+      backslashes &= ~backslash;
+    }
+    return result;
+  }
+
+  // Returns a mask where each bit tells if an odd number of bits are set at
+  // or before this position, i.e. if the char is inside a string.
+  static uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  static uint32_t countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+    uint32_t n = 0;
+    while (!(x & 1)) {
+      x >>= 1;
+      n++;
+    }
+    return n;
+#endif
+  }
+
+  const char* _json;
+  const char* _end;
+  uint32_t* _positions;
+  size_t _size;
+  size_t _capacity;
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
@@ -0,0 +1,62 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <string.h>  // for strcmp
+
+#include "../Data/JsonFloat.hpp"
+#include "../Data/JsonInteger.hpp"
+#include "../JsonVariant.hpp"
+#include "../Polyfills/ctype.hpp"
+#include "../Polyfills/isFloat.hpp"
+#include "../Polyfills/isInteger.hpp"
+#include "../Polyfills/parseFloat.hpp"
+#include "../Polyfills/parseInteger.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Converts a non-quoted value to a boolean, an integer or a float, as
+// JsonVariant::as<T>() would.
+// Returns false for the values that must remain RawJson: null, non-quoted
+// strings, and the integers that don't fit in a JsonInteger or a JsonUInt.
+inline bool parseTypedValue(const char *s, JsonVariant *destination) {
+  if (!strcmp(s, "true")) {
+    *destination = true;
+    return true;
+  }
+
+  if (!strcmp(s, "false")) {
+    *destination = false;
+    return true;
+  }
+
+  if (isInteger(s)) {
+    bool negative = *s == '-';
+    if (issign(*s)) s++;
+
+    JsonUInt value;
+    bool overflow = false;
+    parseDigits(s, value, overflow);
+    if (overflow) return false;
+
+    if (!negative) {
+      *destination = value;
+    } else {
+      if (value > JsonUInt(-1) / 2) return false;
+      *destination = -JsonInteger(value);
+    }
+    return true;
+  }
+
+  if (isFloat(s)) {
+    *destination = parseFloat<JsonFloat>(s);
+    return true;
+  }
+
+  return false;
+}
+}  // namespace Internals
+}  // namespace ArduinoJson
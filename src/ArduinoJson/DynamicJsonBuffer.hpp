@@ -5,6 +5,7 @@
 #pragma once
 
 #include "JsonBufferBase.hpp"
+#include "RetentionPolicy.hpp"
 
 #include <stdlib.h>
 
@@ -30,9 +31,10 @@ class DefaultAllocator {
   }
 };
 
-template <typename TAllocator>
+template <typename TAllocator, typename TRetentionPolicy = ReleaseAllBlocks>
 class DynamicJsonBufferBase
-    : public JsonBufferBase<DynamicJsonBufferBase<TAllocator> > {
+    : public JsonBufferBase<
+          DynamicJsonBufferBase<TAllocator, TRetentionPolicy> > {
   struct Block;
   struct EmptyBlock {
     Block* next;
@@ -46,37 +48,104 @@ class DynamicJsonBufferBase
  public:
   enum { EmptyBlockSize = sizeof(EmptyBlock) };
 
-  DynamicJsonBufferBase(size_t initialSize = 256)
-      : _head(NULL), _nextBlockCapacity(initialSize) {}
+  // The capacity of the blocks doubles, from initialSize up to
+  // maxBlockCapacity; only the allocations larger than that get larger
+  // blocks.
+  DynamicJsonBufferBase(size_t initialSize = 256,
+                        size_t maxBlockCapacity = size_t(-1))
+      : _head(NULL),
+        _nextBlockCapacity(initialSize),
+        _maxBlockCapacity(maxBlockCapacity),
+        _highWaterMark(0),
+        _wastedStringBytes(0),
+        _fullBlocksSize(0) {}
 
   ~DynamicJsonBufferBase() {
-    clear();
+    releaseBlocks(NULL);
   }
 
   // Gets the number of bytes occupied in the buffer
   size_t size() const {
-    size_t total = 0;
-    for (const Block* b = _head; b; b = b->next) total += b->size;
-    return total;
+    return _head ? _fullBlocksSize + _head->size : 0;
+  }
+
+  // Gets the number of bytes left behind by the strings that didn't fit in
+  // a block, and were moved to a new one
+  size_t wastedStringBytes() const {
+    return _wastedStringBytes;
+  }
+
+  // Gets the allocator of the blocks
+  const TAllocator& allocator() const {
+    return _allocator;
   }
 
   // Allocates the specified amount of bytes in the buffer
   virtual void* alloc(size_t bytes) {
-    alignNextAlloc();
+    void* recycled = this->reuse(bytes);
+    if (recycled) {
+      this->recordAllocation(0);
+      return recycled;
+    }
+    this->recordAllocation(alignNextAlloc());
     return canAllocInHead(bytes) ? allocInHead(bytes) : allocInNewBlock(bytes);
   }
 
   // Resets the buffer.
+  // The blocks are released or kept, depending on TRetentionPolicy.
   // USE WITH CAUTION: this invalidates all previously allocated data
   void clear() {
-    Block* currentBlock = _head;
-    while (currentBlock != NULL) {
-      _nextBlockCapacity = currentBlock->capacity;
-      Block* nextBlock = currentBlock->next;
-      _allocator.deallocate(currentBlock);
-      currentBlock = nextBlock;
+    const size_t maxRetained = TRetentionPolicy::max_retained_bytes;
+    if (maxRetained == 0) return releaseBlocks(NULL);
+
+    size_t used = size();
+    if (used > _highWaterMark) _highWaterMark = used;
+    size_t target = this->round_size_up(_highWaterMark);
+    if (target > maxRetained) target = maxRetained;
+
+    // keep the largest block allowed by the policy...
+    Block* kept = NULL;
+    for (Block* b = _head; b; b = b->next) {
+      if (b->capacity > maxRetained) continue;
+      if (!kept || b->capacity > kept->capacity) kept = b;
     }
-    _head = 0;
+    releaseBlocks(kept);
+
+    // ...or merge the blocks into one that can hold the high-water mark
+    size_t keptCapacity = kept ? kept->capacity : 0;
+    if (keptCapacity < target) {
+      releaseBlocks(NULL);
+      if (!addNewBlock(target) && keptCapacity) addNewBlock(keptCapacity);
+    }
+    if (_head) _nextBlockCapacity = _head->capacity;
+  }
+
+  // Copies root in one block of the exact size, then releases the other
+  // blocks.
+  // Returns the copy, or root itself if the block couldn't be allocated.
+  // USE WITH CAUTION: this invalidates all previously allocated data, except
+  // the returned value
+  JsonVariant shrinkToFit(const JsonVariant& root) {
+    size_t bytes = root.compactSize();
+    Block* oldBlocks = _head;
+    size_t oldBlocksSize = _fullBlocksSize;
+    _head = NULL;
+    _fullBlocksSize = 0;
+    this->resetFreeLists();
+    if (bytes > 0 && !addNewBlock(bytes)) {
+      _head = oldBlocks;
+      _fullBlocksSize = oldBlocksSize;
+      return root;
+    }
+
+    JsonVariant copy = root.compactInto(*this);
+
+    Block* newBlock = _head;
+    _head = oldBlocks;
+    releaseBlocks(NULL);
+    _head = newBlock;
+    if (newBlock) this->recordSize(newBlock->size);
+    return copy;
   }
 
   class String {
@@ -85,18 +154,14 @@ class DynamicJsonBufferBase
         : _parent(parent), _start(NULL), _length(0) {}
 
     void append(char c) {
-      if (_parent->canAllocInHead(1)) {
-        char* end = static_cast<char*>(_parent->allocInHead(1));
-        *end = c;
-        if (_length == 0) _start = end;
-      } else {
-        char* newStart =
-            static_cast<char*>(_parent->allocInNewBlock(_length + 1));
-        if (_start && newStart) memcpy(newStart, _start, _length);
-        if (newStart) newStart[_length] = c;
-        _start = newStart;
-      }
-      _length++;
+      char* end = grow(1);
+      if (end) *end = c;
+    }
+
+    void append(const char* s, size_t n) {
+      if (n == 0) return;
+      char* end = grow(n);
+      if (end) memcpy(end, s, n);
     }
 
     const char* c_str() {
@@ -104,7 +169,40 @@ class DynamicJsonBufferBase
       return _start;
     }
 
+    // Releases the memory of the string.
+    // Nothing must have been allocated after it.
+    void discard() {
+      if (!_start) return;
+      char* data = reinterpret_cast<char*>(_parent->_head->data);
+      _parent->_head->size = static_cast<size_t>(_start - data);
+      _parent->recordSize(_parent->size());
+    }
+
    private:
+    // Returns where the next n chars go, or NULL if there is no memory.
+    // When the head block is full, the string moves to a new block that can
+    // hold twice its length, so it's copied O(log(length)) times.
+    char* grow(size_t n) {
+      if (_parent->canAllocInHead(n)) {
+        char* end = static_cast<char*>(_parent->allocInHead(n));
+        if (_length == 0) _start = end;
+        _length += n;
+        return end;
+      }
+
+      size_t newLength = _length + n;
+      char* newStart = static_cast<char*>(
+          _parent->allocInNewBlock(newLength, 2 * newLength));
+      if (_start) {
+        if (newStart) memcpy(newStart, _start, _length);
+        _parent->_wastedStringBytes += _length;
+      }
+      _start = newStart;
+      char* end = newStart ? newStart + _length : NULL;
+      _length = newLength;
+      return end;
+    }
+
     DynamicJsonBufferBase* _parent;
     char* _start;
     size_t _length;
@@ -114,9 +212,23 @@ class DynamicJsonBufferBase
     return String(this);
   }
 
+ protected:
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  virtual bool owns(const void* p) const {
+    for (const Block* b = _head; b; b = b->next) {
+      if (p >= b->data && p < b->data + b->size) return true;
+    }
+    return false;
+  }
+#endif
+
  private:
-  void alignNextAlloc() {
-    if (_head) _head->size = this->round_size_up(_head->size);
+  // Returns the number of bytes skipped
+  size_t alignNextAlloc() {
+    if (!_head) return 0;
+    size_t oldSize = _head->size;
+    _head->size = this->round_size_up(oldSize);
+    return _head->size - oldSize;
   }
 
   bool canAllocInHead(size_t bytes) const {
@@ -126,17 +238,50 @@ class DynamicJsonBufferBase
   void* allocInHead(size_t bytes) {
     void* p = _head->data + _head->size;
     _head->size += bytes;
+    this->recordSize(size());
     return p;
   }
 
-  void* allocInNewBlock(size_t bytes) {
+  // Allocates the bytes in a new block.
+  // If possible, the block can hold at least `reserve` bytes.
+  void* allocInNewBlock(size_t bytes, size_t reserve = 0) {
     size_t capacity = _nextBlockCapacity;
+    if (capacity > _maxBlockCapacity) capacity = _maxBlockCapacity;
     if (bytes > capacity) capacity = bytes;
-    if (!addNewBlock(capacity)) return NULL;
-    _nextBlockCapacity *= 2;
+    if (reserve <= capacity || reserve > _maxBlockCapacity ||
+        !addNewBlock(reserve)) {
+      if (!addNewBlock(capacity)) return NULL;
+    }
+    if (_nextBlockCapacity <= _maxBlockCapacity / 2)
+      _nextBlockCapacity *= 2;
+    else
+      _nextBlockCapacity = _maxBlockCapacity;
     return allocInHead(bytes);
   }
 
+  // Releases all the blocks except one
+  void releaseBlocks(Block* kept) {
+    Block* currentBlock = _head;
+    while (currentBlock != NULL) {
+      Block* nextBlock = currentBlock->next;
+      if (currentBlock != kept) {
+        _nextBlockCapacity = currentBlock->capacity;
+        _allocator.deallocate(currentBlock);
+        this->recordReleasedBlock();
+      }
+      currentBlock = nextBlock;
+    }
+    _head = kept;
+    _wastedStringBytes = 0;
+    _fullBlocksSize = 0;
+    this->recordClear();
+    this->resetFreeLists();
+    if (kept) {
+      kept->next = NULL;
+      kept->size = 0;
+    }
+  }
+
   bool addNewBlock(size_t capacity) {
     size_t bytes = EmptyBlockSize + capacity;
     Block* block = static_cast<Block*>(_allocator.allocate(bytes));
@@ -144,13 +289,19 @@ class DynamicJsonBufferBase
     block->capacity = capacity;
     block->size = 0;
     block->next = _head;
+    if (_head) _fullBlocksSize += _head->size;
     _head = block;
+    this->recordNewBlock();
     return true;
   }
 
   TAllocator _allocator;
   Block* _head;
   size_t _nextBlockCapacity;
+  size_t _maxBlockCapacity;
+  size_t _highWaterMark;
+  size_t _wastedStringBytes;
+  size_t _fullBlocksSize;  // the sum of the sizes, except for the head
 };
 }
 
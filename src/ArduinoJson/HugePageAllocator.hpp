@@ -0,0 +1,195 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Configuration.hpp"
+
+#if ARDUINOJSON_ENABLE_MMAP
+
+#include <stdint.h>  // for uintptr_t
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Data/NonCopyable.hpp"
+#include "DynamicJsonBuffer.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic push
+#endif
+#pragma GCC diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+namespace ArduinoJson {
+
+// An allocator for DynamicJsonBuffer, for documents of hundreds of megabytes.
+// The allocations of MIN_MAPPED_SIZE bytes or more are mapped with mmap(),
+// aligned on 2 MB, and marked with MADV_HUGEPAGE when the system has it, so
+// they need fewer TLB entries and fewer page faults. The smaller allocations
+// go to malloc().
+//
+// With PREFAULT, the pages are touched as soon as they are mapped, instead of
+// during the parsing.
+// The mappings are not returned to the system right away: each allocator keeps
+// up to MAX_POOLED_BYTES for the next blocks, until it's destroyed.
+//
+// Use HugePageJsonBuffer, whose blocks fill the huge pages exactly.
+template <size_t MIN_MAPPED_SIZE = 2 * 1024 * 1024,
+          size_t MAX_POOLED_BYTES = 64 * 1024 * 1024, bool PREFAULT = false>
+class HugePageAllocator : Internals::NonCopyable {
+  struct Header {
+    size_t mappedSize;  // 0 for the allocations made with malloc()
+    Header* next;       // when the mapping is in the pool
+  };
+
+ public:
+  static const size_t huge_page_size = 2 * 1024 * 1024;
+
+  // The bytes added to each allocation
+  static const size_t overhead = sizeof(Header);
+
+  HugePageAllocator() : _pool(NULL), _pooledBytes(0), _mappedBytes(0) {}
+
+  ~HugePageAllocator() {
+    while (_pool) {
+      Header* next = _pool->next;
+      unmap(_pool);
+      _pool = next;
+    }
+  }
+
+  void* allocate(size_t size) {
+    size_t total = overhead + size;
+    if (total < size) return NULL;  // overflow
+
+    Header* block;
+    if (total < MIN_MAPPED_SIZE) {
+      block = static_cast<Header*>(malloc(total));
+      if (block) block->mappedSize = 0;
+    } else {
+      size_t mappedSize = (total + huge_page_size - 1) & ~(huge_page_size - 1);
+      if (mappedSize < total) return NULL;  // overflow
+      block = takeFromPool(mappedSize);
+      if (!block) block = map(mappedSize);
+    }
+    return block ? block + 1 : NULL;
+  }
+
+  void deallocate(void* pointer) {
+    if (!pointer) return;
+    Header* block = static_cast<Header*>(pointer) - 1;
+    if (!block->mappedSize) return free(block);
+    if (_pooledBytes + block->mappedSize > MAX_POOLED_BYTES) return unmap(block);
+    block->next = _pool;
+    _pool = block;
+    _pooledBytes += block->mappedSize;
+  }
+
+  // Gets the number of bytes mapped, including the pool
+  size_t mappedBytes() const {
+    return _mappedBytes;
+  }
+
+  // Gets the number of bytes in the pool
+  size_t pooledBytes() const {
+    return _pooledBytes;
+  }
+
+ private:
+  // Takes the smallest mapping of the pool that is large enough
+  Header* takeFromPool(size_t size) {
+    Header** best = NULL;
+    for (Header** p = &_pool; *p; p = &(*p)->next) {
+      if ((*p)->mappedSize < size) continue;
+      if (!best || (*p)->mappedSize < (*best)->mappedSize) best = p;
+    }
+    if (!best) return NULL;
+    Header* block = *best;
+    *best = block->next;
+    _pooledBytes -= block->mappedSize;
+    return block;
+  }
+
+  Header* map(size_t size) {
+    // Map one more huge page, then trim the ends to get an aligned mapping
+    size_t rawSize = size + huge_page_size;
+    if (rawSize < size) return NULL;  // overflow
+    void* raw = mmap(NULL, rawSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+
+    char* start = static_cast<char*>(raw);
+    size_t head = (huge_page_size -
+                   reinterpret_cast<uintptr_t>(start) % huge_page_size) %
+                  huge_page_size;
+    if (head) munmap(start, head);
+    munmap(start + head + size, huge_page_size - head);
+    start += head;
+
+#ifdef MADV_HUGEPAGE
+    madvise(start, size, MADV_HUGEPAGE);
+#endif
+    if (PREFAULT) prefault(start, size);
+
+    Header* block = reinterpret_cast<Header*>(start);
+    block->mappedSize = size;
+    _mappedBytes += size;
+    return block;
+  }
+
+  void unmap(Header* block) {
+    _mappedBytes -= block->mappedSize;
+    munmap(block, block->mappedSize);
+  }
+
+  // Writes one byte in each page, so the kernel allocates them now
+  static void prefault(char* start, size_t size) {
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < size; i += pageSize) {
+      static_cast<volatile char*>(start)[i] = 0;
+    }
+  }
+
+  Header* _pool;
+  size_t _pooledBytes;
+  size_t _mappedBytes;
+};
+
+// A DynamicJsonBuffer whose blocks come from HugePageAllocator.
+// The first block fills a huge page; since the capacity doubles, the
+// following blocks fill 2, 4, 8... huge pages, up to the maximum capacity,
+// which fills 32 huge pages by default.
+template <typename TAllocator = HugePageAllocator<> >
+class HugePageJsonBufferBase
+    : public Internals::DynamicJsonBufferBase<TAllocator> {
+  typedef Internals::DynamicJsonBufferBase<TAllocator> base;
+
+ public:
+  static size_t blockCapacity(size_t hugePages) {
+    return hugePages * TAllocator::huge_page_size - TAllocator::overhead -
+           base::EmptyBlockSize;
+  }
+
+  HugePageJsonBufferBase() : base(blockCapacity(1), blockCapacity(32)) {}
+  HugePageJsonBufferBase(size_t initialSize, size_t maxBlockCapacity)
+      : base(initialSize, maxBlockCapacity) {}
+};
+
+typedef HugePageJsonBufferBase<> HugePageJsonBuffer;
+}  // namespace ArduinoJson
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#endif
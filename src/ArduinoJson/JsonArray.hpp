@@ -18,8 +18,20 @@
 
 // Returns the size (in bytes) of an array with n elements.
 // Can be very handy to determine the size of a StaticJsonBuffer.
-#define JSON_ARRAY_SIZE(NUMBER_OF_ELEMENTS) \
-  (sizeof(JsonArray) + (NUMBER_OF_ELEMENTS) * sizeof(JsonArray::node_type))
+#define JSON_ARRAY_SIZE(NUMBER_OF_ELEMENTS)                                \
+  (sizeof(JsonArray) + (NUMBER_OF_ELEMENTS) * sizeof(JsonArray::node_type) + \
+   JSON_ARRAY_INDEX_SIZE(NUMBER_OF_ELEMENTS))
+
+// Returns the maximum size (in bytes) of the index of an array with n
+// elements, see ARDUINOJSON_ARRAY_INDEX_THRESHOLD.
+// The index grows by doubling, so it takes less than six words per
+// ARDUINOJSON_ARRAY_INDEX_STRIDE elements, including the discarded copies.
+#define JSON_ARRAY_INDEX_SIZE(NUMBER_OF_ELEMENTS)                        \
+  (ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0 &&                              \
+           (NUMBER_OF_ELEMENTS) > ARDUINOJSON_ARRAY_INDEX_THRESHOLD       \
+       ? 6 * ((NUMBER_OF_ELEMENTS) / ARDUINOJSON_ARRAY_INDEX_STRIDE + 1) * \
+             sizeof(void *)                                               \
+       : 0)
 
 namespace ArduinoJson {
 
@@ -36,6 +48,10 @@ class JsonArraySubscript;
 // JsonBuffer::createArray() or JsonBuffer::parseArray().
 // A JsonArray can be serialized to a JSON string via JsonArray::printTo().
 // It can also be deserialized from a JSON string via JsonBuffer::parseArray().
+//
+// Once an array has more than ARDUINOJSON_ARRAY_INDEX_THRESHOLD elements, it
+// keeps an index of every ARDUINOJSON_ARRAY_INDEX_STRIDE-th node in the
+// JsonBuffer, so get(), set() and operator[] don't walk the whole list.
 class JsonArray : public Internals::JsonPrintable<JsonArray>,
                   public Internals::ReferenceType,
                   public Internals::NonCopyable,
@@ -46,7 +62,11 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
   // You should not call this constructor directly.
   // Instead, use JsonBuffer::createArray() or JsonBuffer::parseArray().
   explicit JsonArray(JsonBuffer *buffer) throw()
-      : Internals::List<JsonVariant>(buffer) {}
+      : Internals::List<JsonVariant>(buffer) {
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0
+    _index = NULL;
+#endif
+  }
 
   // Gets the value at the specified index
   const Internals::JsonArraySubscript operator[](size_t index) const;
@@ -107,14 +127,14 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
   // Gets the value at the specified index.
   template <typename T>
   typename Internals::JsonVariantAs<T>::type get(size_t index) const {
-    const_iterator it = begin() += index;
+    const_iterator it(findNode(index));
     return it != end() ? it->as<T>() : Internals::JsonVariantDefault<T>::get();
   }
 
   // Check the type of the value at specified index.
   template <typename T>
   bool is(size_t index) const {
-    const_iterator it = begin() += index;
+    const_iterator it(findNode(index));
     return it != end() ? it->is<T>() : false;
   }
 
@@ -128,9 +148,40 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
 
   // Removes element at specified index.
   void remove(size_t index) {
-    remove(begin() += index);
+    remove(iterator(findNode(index)));
+  }
+
+  // Removes the element at the specified position.
+  void remove(iterator it) {
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0
+    if (_index && it != end()) unindexNode(it);
+#endif
+    Internals::List<JsonVariant>::remove(it);
+  }
+
+  // Tells if the index must grow when the element at the specified position
+  // is added; if so, updates its capacity and returns the number of bytes
+  // allocated.
+  // Used by JsonVariant::compactSize().
+  static size_t growIndex(size_t position, size_t &capacity) {
+    const size_t threshold = ARDUINOJSON_ARRAY_INDEX_THRESHOLD;
+    const size_t stride = ARDUINOJSON_ARRAY_INDEX_STRIDE;
+    if (threshold == 0 || position < threshold || position % stride) return 0;
+    size_t entry = position / stride;
+    if (entry < capacity) return 0;
+    capacity = 2 * (entry + 1);
+    return indexSize(capacity);
+  }
+
+  // Adds an empty element at the end of the array, and updates the index.
+  // Returns end() if the allocation failed.
+  iterator addNode() {
+    iterator it = Internals::List<JsonVariant>::add();
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0
+    if (it != end()) updateIndex();
+#endif
+    return it;
   }
-  using Internals::List<JsonVariant>::remove;
 
   // Returns a reference an invalid JsonArray.
   // This object is meant to replace a NULL pointer.
@@ -203,17 +254,104 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
  private:
   template <typename TValueRef>
   bool set_impl(size_t index, TValueRef value) {
-    iterator it = begin() += index;
+    iterator it(findNode(index));
     if (it == end()) return false;
     return Internals::ValueSaver<TValueRef>::save(_buffer, *it, value);
   }
 
   template <typename TValueRef>
   bool add_impl(TValueRef value) {
-    iterator it = Internals::List<JsonVariant>::add();
+    iterator it = addNode();
     if (it == end()) return false;
     return Internals::ValueSaver<TValueRef>::save(_buffer, *it, value);
   }
+
+  // Points to every ARDUINOJSON_ARRAY_INDEX_STRIDE-th node
+  struct Index {
+    size_t capacity;
+    size_t entries;
+    node_type *nodes[1];  // followed by the other entries
+  };
+
+  // Returns the node at the specified index, or NULL
+  node_type *findNode(size_t index) const {
+    if (index >= size()) return NULL;
+
+    node_type *node = firstNode();
+    size_t position = 0;
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0
+    if (_index && _index->entries > 0) {
+      size_t entry = index / ARDUINOJSON_ARRAY_INDEX_STRIDE;
+      if (entry >= _index->entries) entry = _index->entries - 1;
+      node = _index->nodes[entry];
+      position = entry * ARDUINOJSON_ARRAY_INDEX_STRIDE;
+    }
+#endif
+    for (; position < index; position++) node = node->next;
+    return node;
+  }
+
+  static size_t indexSize(size_t capacity) {
+    return sizeof(Index) + (capacity - 1) * sizeof(node_type *);
+  }
+
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD > 0
+  // Adds the last node to the index, if it's one of the indexed nodes.
+  // The index is built when the array passes the threshold.
+  void updateIndex() {
+    const size_t stride = ARDUINOJSON_ARRAY_INDEX_STRIDE;
+    size_t position = size() - 1;
+    size_t capacity = _index ? _index->capacity : 0;
+    if (growIndex(position, capacity) && !reallocIndex(capacity)) return;
+    if (!_index || position % stride) return;
+
+    if (position / stride == _index->entries) {
+      _index->nodes[_index->entries++] = lastNode();
+      return;
+    }
+
+    // the index is incomplete, rebuild it from the beginning
+    _index->entries = 0;
+    size_t i = 0;
+    for (node_type *node = firstNode(); node; node = node->next, i++) {
+      if (i % stride == 0) _index->nodes[_index->entries++] = node;
+    }
+  }
+
+  bool reallocIndex(size_t capacity) {
+    Index *newIndex = static_cast<Index *>(_buffer->alloc(indexSize(capacity)));
+    if (!newIndex) return false;
+    newIndex->capacity = capacity;
+    newIndex->entries = 0;
+    if (_index) {
+      newIndex->entries = _index->entries;
+      for (size_t i = 0; i < _index->entries; i++)
+        newIndex->nodes[i] = _index->nodes[i];
+      _buffer->release(_index, indexSize(_index->capacity));
+    }
+    _index = newIndex;
+    return true;
+  }
+
+  // Moves the entries that follow the specified node to the next node, as
+  // the node is about to be removed.
+  void unindexNode(iterator it) {
+    const size_t stride = ARDUINOJSON_ARRAY_INDEX_STRIDE;
+    size_t position = 0;
+    const node_type *node = firstNode();
+    for (; node && &node->content != &*it; node = node->next) position++;
+    if (!node) return;  // not in this array
+
+    size_t entry = (position + stride - 1) / stride;
+    for (; entry < _index->entries; entry++) {
+      _index->nodes[entry] = _index->nodes[entry]->next;
+      // the last entry was the last node
+      if (!_index->nodes[entry]) _index->entries = entry;
+    }
+  }
+
+  Index *_index;
+#endif
 };
 
 namespace Internals {
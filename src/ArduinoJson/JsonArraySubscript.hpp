@@ -52,6 +52,11 @@ class JsonArraySubscript : public JsonVariantBase<JsonArraySubscript> {
     return _array.get<T>(_index);
   }
 
+  template <typename T>
+  FORCE_INLINE bool as(T& value) const {
+    return _array.get<JsonVariant>(_index).as(value);
+  }
+
   template <typename T>
   FORCE_INLINE bool is() const {
     return _array.is<T>(_index);
@@ -17,6 +17,19 @@ namespace ArduinoJson {
 class JsonArray;
 class JsonObject;
 
+#if ARDUINOJSON_ENABLE_STATISTICS
+// The memory statistics of a JsonBuffer, see JsonBuffer::stats().
+// clear() resets all of them, except peakBytes and allocations.
+struct JsonBufferStats {
+  size_t currentBytes;   // bytes in use, like size()
+  size_t peakBytes;      // the largest value of currentBytes
+  size_t allocations;    // calls to alloc()
+  size_t blocks;         // blocks of memory
+  size_t paddingBytes;   // bytes skipped to align the allocations
+  size_t orphanedBytes;  // bytes of the nodes removed from arrays and objects
+};
+#endif
+
 // Entry point for using the library.
 //
 // Handle the memory management (done in derived classes) and calls the parser.
@@ -59,12 +72,6 @@ class JsonBuffer : Internals::NonCopyable {
   // Return a pointer to the allocated memory or NULL if allocation fails.
   virtual void *alloc(size_t size) = 0;
 
- protected:
-  // CAUTION: NO VIRTUAL DESTRUCTOR!
-  // If we add a virtual constructor the Arduino compiler will add malloc()
-  // and free() to the binary, adding 706 useless bytes.
-  ~JsonBuffer() {}
-
   // Preserve aligment if necessary
   static FORCE_INLINE size_t round_size_up(size_t bytes) {
 #if ARDUINOJSON_ENABLE_ALIGNMENT
@@ -74,5 +81,141 @@ class JsonBuffer : Internals::NonCopyable {
     return bytes;
 #endif
   }
+
+#if ARDUINOJSON_ENABLE_STATISTICS
+  // Gets the memory statistics, in constant time
+  const JsonBufferStats &stats() const {
+    return _stats;
+  }
+
+  // Called by JsonArray and JsonObject when they remove a node
+  void recordOrphan(size_t bytes) {
+    _stats.orphanedBytes += round_size_up(bytes);
+  }
+#else
+  void recordOrphan(size_t) {}
+#endif
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // Called by JsonArray and JsonObject when they remove a node or an index,
+  // so that alloc() can reuse its memory.
+  // The strings are never released, because other variants may point to them.
+  void release(const void *p, size_t bytes) {
+    if (!p || !owns(p)) return;
+    // The nodes and the indexes come from alloc(), which starts them on a
+    // word boundary, so the padding up to the next word belongs to this block
+    uintptr_t address = reinterpret_cast<uintptr_t>(p);
+    if (round_size_up(size_t(address)) != size_t(address)) return;
+    bytes = round_size_up(bytes);
+    if (bytes < sizeof(FreeChunk *)) return;  // too small to recycle
+
+    FreeChunk *chunk = static_cast<FreeChunk *>(const_cast<void *>(p));
+    size_t index = freeListIndex(bytes / sizeof(void *));
+    if (index == FreeListCount - 1) chunk->size = bytes;
+    chunk->next = _freeLists[index];
+    _freeLists[index] = chunk;
+  }
+#else
+  void release(const void *, size_t) {}
+#endif
+
+ protected:
+  // CAUTION: NO VIRTUAL DESTRUCTOR!
+  // If we add a virtual constructor the Arduino compiler will add malloc()
+  // and free() to the binary, adding 706 useless bytes.
+  ~JsonBuffer() {}
+
+  // The derived classes report the events to the statistics.
+  // These functions are empty unless ARDUINOJSON_ENABLE_STATISTICS is set.
+#if ARDUINOJSON_ENABLE_STATISTICS
+  JsonBuffer() : _stats() {
+    resetFreeLists();
+  }
+#else
+  JsonBuffer() {
+    resetFreeLists();
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_STATISTICS
+
+  void recordSize(size_t bytes) {
+    _stats.currentBytes = bytes;
+    if (bytes > _stats.peakBytes) _stats.peakBytes = bytes;
+  }
+  void recordAllocation(size_t padding) {
+    _stats.allocations++;
+    _stats.paddingBytes += padding;
+  }
+  void recordNewBlock() {
+    _stats.blocks++;
+  }
+  void recordReleasedBlock() {
+    _stats.blocks--;
+  }
+  void recordClear() {
+    _stats.currentBytes = 0;
+    _stats.paddingBytes = 0;
+    _stats.orphanedBytes = 0;
+  }
+#else
+  void recordSize(size_t) {}
+  void recordAllocation(size_t) {}
+  void recordNewBlock() {}
+  void recordReleasedBlock() {}
+  void recordClear() {}
+#endif
+
+  // The derived classes call reuse() before allocating, and resetFreeLists()
+  // when they release their memory.
+  // These functions are empty unless ARDUINOJSON_ENABLE_FREE_LISTS is set.
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  void *reuse(size_t bytes) {
+    size_t index = freeListIndex((bytes + sizeof(void *) - 1) / sizeof(void *));
+    FreeChunk **link = &_freeLists[index];
+    if (index == FreeListCount - 1) {
+      while (*link && (*link)->size < bytes) link = &(*link)->next;
+    }
+    FreeChunk *chunk = *link;
+    if (chunk) *link = chunk->next;
+    return chunk;
+  }
+  void resetFreeLists() {
+    for (size_t i = 0; i < FreeListCount; i++) _freeLists[i] = NULL;
+  }
+
+  // Tells if p points to the memory of this JsonBuffer
+  virtual bool owns(const void *p) const = 0;
+#else
+  void *reuse(size_t) {
+    return NULL;
+  }
+  void resetFreeLists() {}
+#endif
+
+ private:
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // A block in a free list.
+  // The lists contain blocks of 1, 2... 7 words, and the last one contains
+  // the larger blocks, so it's the only one where the size is stored.
+  struct FreeChunk {
+    FreeChunk *next;
+    size_t size;
+  };
+
+  enum { FreeListCount = 8 };
+
+  static size_t freeListIndex(size_t words) {
+    const size_t last = FreeListCount - 1;
+    if (words == 0) return 0;
+    return words - 1 < last ? words - 1 : last;
+  }
+
+  FreeChunk *_freeLists[FreeListCount];
+#endif
+
+#if ARDUINOJSON_ENABLE_STATISTICS
+  JsonBufferStats _stats;
+#endif
 };
 }
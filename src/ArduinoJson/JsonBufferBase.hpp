@@ -7,6 +7,8 @@
 #include "Deserialization/JsonParser.hpp"
 
 namespace ArduinoJson {
+class JsonFilter;
+
 namespace Internals {
 template <typename TDerived>
 class JsonBufferBase : public JsonBuffer {
@@ -48,6 +50,68 @@ class JsonBufferBase : public JsonBuffer {
       TString &json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
     return Internals::makeParser(that(), json, nestingLimit).parseArray();
   }
+  //
+  // JsonArray& parseArray<TPolicy>(TString);
+  // TPolicy = DefaultParsing, StructuralIndexParsing, EagerTypingParsing,
+  //           TrustedInputParsing
+  // TString = const std::string&, const String&
+  template <typename TPolicy, typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonArray &>::type
+  parseArray(const TString &json,
+             uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseArray();
+  }
+  //
+  // JsonArray& parseArray<TPolicy>(TString);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TPolicy, typename TString>
+  JsonArray &parseArray(
+      TString *json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseArray();
+  }
+  //
+  // JsonArray& parseArray<TPolicy>(TString);
+  // TString = std::istream&, Stream&
+  template <typename TPolicy, typename TString>
+  JsonArray &parseArray(
+      TString &json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseArray();
+  }
+  //
+  // JsonArray& parseArray(TString, JsonFilter);
+  // TString = const std::string&, const String&
+  template <typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonArray &>::type
+  parseArray(const TString &json, const JsonFilter &filter,
+             uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseArray();
+  }
+  //
+  // JsonArray& parseArray(TString, JsonFilter);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TString>
+  JsonArray &parseArray(
+      TString *json, const JsonFilter &filter,
+      uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseArray();
+  }
+  //
+  // JsonArray& parseArray(TString, JsonFilter);
+  // TString = std::istream&, Stream&
+  template <typename TString>
+  JsonArray &parseArray(
+      TString &json, const JsonFilter &filter,
+      uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseArray();
+  }
 
   // Allocates and populate a JsonObject from a JSON string.
   //
@@ -85,6 +149,68 @@ class JsonBufferBase : public JsonBuffer {
       TString &json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
     return Internals::makeParser(that(), json, nestingLimit).parseObject();
   }
+  //
+  // JsonObject& parseObject<TPolicy>(TString);
+  // TPolicy = DefaultParsing, StructuralIndexParsing, EagerTypingParsing,
+  //           TrustedInputParsing
+  // TString = const std::string&, const String&
+  template <typename TPolicy, typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonObject &>::type
+  parseObject(const TString &json,
+              uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseObject();
+  }
+  //
+  // JsonObject& parseObject<TPolicy>(TString);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TPolicy, typename TString>
+  JsonObject &parseObject(
+      TString *json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseObject();
+  }
+  //
+  // JsonObject& parseObject<TPolicy>(TString);
+  // TString = std::istream&, Stream&
+  template <typename TPolicy, typename TString>
+  JsonObject &parseObject(
+      TString &json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseObject();
+  }
+  //
+  // JsonObject& parseObject(TString, JsonFilter);
+  // TString = const std::string&, const String&
+  template <typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonObject &>::type
+  parseObject(const TString &json, const JsonFilter &filter,
+              uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseObject();
+  }
+  //
+  // JsonObject& parseObject(TString, JsonFilter);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TString>
+  JsonObject &parseObject(
+      TString *json, const JsonFilter &filter,
+      uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseObject();
+  }
+  //
+  // JsonObject& parseObject(TString, JsonFilter);
+  // TString = std::istream&, Stream&
+  template <typename TString>
+  JsonObject &parseObject(
+      TString &json, const JsonFilter &filter,
+      uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseObject();
+  }
 
   // Generalized version of parseArray() and parseObject(), also works for
   // integral types.
@@ -114,6 +240,66 @@ class JsonBufferBase : public JsonBuffer {
                     uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
     return Internals::makeParser(that(), json, nestingLimit).parseVariant();
   }
+  //
+  // JsonVariant parse<TPolicy>(TString);
+  // TPolicy = DefaultParsing, StructuralIndexParsing, EagerTypingParsing,
+  //           TrustedInputParsing
+  // TString = const std::string&, const String&
+  template <typename TPolicy, typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonVariant>::type
+  parse(const TString &json,
+        uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseVariant();
+  }
+  //
+  // JsonVariant parse<TPolicy>(TString);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TPolicy, typename TString>
+  JsonVariant parse(TString *json,
+                    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseVariant();
+  }
+  //
+  // JsonVariant parse<TPolicy>(TString);
+  // TString = std::istream&, Stream&
+  template <typename TPolicy, typename TString>
+  JsonVariant parse(TString &json,
+                    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser<TPolicy>(that(), json, nestingLimit)
+        .parseVariant();
+  }
+  //
+  // JsonVariant parse(TString, JsonFilter);
+  // TString = const std::string&, const String&
+  template <typename TString>
+  typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                               JsonVariant>::type
+  parse(const TString &json, const JsonFilter &filter,
+        uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseVariant();
+  }
+  //
+  // JsonVariant parse(TString, JsonFilter);
+  // TString = const char*, const char[N], const FlashStringHelper*
+  template <typename TString>
+  JsonVariant parse(TString *json, const JsonFilter &filter,
+                    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseVariant();
+  }
+  //
+  // JsonVariant parse(TString, JsonFilter);
+  // TString = std::istream&, Stream&
+  template <typename TString>
+  JsonVariant parse(TString &json, const JsonFilter &filter,
+                    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+    return Internals::makeParser(that(), json, nestingLimit, filter)
+        .parseVariant();
+  }
 
  protected:
   ~JsonBufferBase() {}
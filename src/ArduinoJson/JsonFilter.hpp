@@ -0,0 +1,62 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "JsonArray.hpp"
+#include "JsonObject.hpp"
+#include "JsonVariant.hpp"
+
+namespace ArduinoJson {
+
+// Tells JsonBuffer::parse(), parseArray() and parseObject() which values to
+// keep; the others are skipped without allocating anything.
+//
+// The filter is a JsonVariant with the shape of the document:
+// - true keeps the value and everything below,
+// - an object keeps the members whose filter is in the object,
+// - an array keeps the elements that match its first element.
+//
+// For example, {"data":[{"id":true,"price":true}]} keeps only "id" and
+// "price" in each element of "data".
+// A JsonVariant must be wrapped explicitly, as in JsonFilter(variant), because
+// it is also convertible to the nesting limit.
+class JsonFilter {
+ public:
+  JsonFilter(const JsonVariant &filter) : _filter(filter) {}
+  JsonFilter(const JsonObject &filter) : _filter(filter) {}
+  JsonFilter(const JsonArray &filter) : _filter(filter) {}
+
+  bool allowArray() const {
+    return allowAll() || _filter.is<JsonArray>();
+  }
+
+  bool allowObject() const {
+    return allowAll() || _filter.is<JsonObject>();
+  }
+
+  bool allowValue() const {
+    return allowAll();
+  }
+
+  // Gets the filter of a member of an object
+  JsonFilter operator[](const char *key) const {
+    if (allowAll()) return *this;
+    return JsonFilter(_filter.as<JsonObject>().get<JsonVariant>(key));
+  }
+
+  // Gets the filter of the elements of an array
+  JsonFilter element() const {
+    if (allowAll()) return *this;
+    return JsonFilter(_filter.as<JsonArray>().get<JsonVariant>(0));
+  }
+
+ private:
+  bool allowAll() const {
+    return _filter.is<bool>() && _filter.as<bool>();
+  }
+
+  JsonVariant _filter;
+};
+}  // namespace ArduinoJson
@@ -0,0 +1,86 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Configuration.hpp"
+#include "Deserialization/JsonEventParser.hpp"
+#include "TypeTraits/IsArray.hpp"
+
+namespace ArduinoJson {
+
+// A handler for parseJsonEvents() that ignores everything.
+// Derive from this class and hide the functions you need; they are resolved
+// at compile time, so there is no virtual call.
+// Each function returns false to stop the parsing.
+//
+// The strings are only valid during the call; numbers are passed as text, use
+// JsonVariant or strtod() to convert them.
+struct JsonHandler {
+  bool startObject() {
+    return true;
+  }
+  bool endObject() {
+    return true;
+  }
+  bool startArray() {
+    return true;
+  }
+  bool endArray() {
+    return true;
+  }
+  bool key(const char *) {
+    return true;
+  }
+  bool string(const char *) {
+    return true;
+  }
+  bool number(const char *) {
+    return true;
+  }
+  bool boolean(bool) {
+    return true;
+  }
+  bool null() {
+    return true;
+  }
+};
+
+// Parses a JSON document and calls the handler for each token, without
+// allocating anything in a JsonBuffer.
+//
+// With a writable char*, the strings are unescaped in place; with the other
+// inputs, the strings are copied in a buffer of ARDUINOJSON_EVENT_STRING_SIZE
+// bytes on the stack, and longer strings make the parsing fail.
+//
+// Returns false if the input is invalid, or if the handler stopped the parsing.
+//
+// bool parseJsonEvents(TString, THandler&);
+// TString = const std::string&, const String&
+template <typename TString, typename THandler>
+typename Internals::EnableIf<!Internals::IsArray<TString>::value, bool>::type
+parseJsonEvents(const TString &json, THandler &handler,
+                uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  return Internals::JsonEventParserBuilder<const TString, THandler>::parse(
+      json, handler, nestingLimit);
+}
+//
+// bool parseJsonEvents(TString, THandler&);
+// TString = char*, const char*, const char[N], const FlashStringHelper*
+template <typename TString, typename THandler>
+bool parseJsonEvents(TString *json, THandler &handler,
+                     uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  return Internals::JsonEventParserBuilder<TString *, THandler>::parse(
+      json, handler, nestingLimit);
+}
+//
+// bool parseJsonEvents(TString, THandler&);
+// TString = std::istream&, Stream&
+template <typename TString, typename THandler>
+bool parseJsonEvents(TString &json, THandler &handler,
+                     uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  return Internals::JsonEventParserBuilder<TString, THandler>::parse(
+      json, handler, nestingLimit);
+}
+}  // namespace ArduinoJson
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint32_t
+
 #include "Data/JsonBufferAllocated.hpp"
 #include "Data/List.hpp"
 #include "Data/ReferenceType.hpp"
@@ -18,8 +20,18 @@
 
 // Returns the size (in bytes) of an object with n elements.
 // Can be very handy to determine the size of a StaticJsonBuffer.
-#define JSON_OBJECT_SIZE(NUMBER_OF_ELEMENTS) \
-  (sizeof(JsonObject) + (NUMBER_OF_ELEMENTS) * sizeof(JsonObject::node_type))
+#define JSON_OBJECT_SIZE(NUMBER_OF_ELEMENTS)                                  \
+  (sizeof(JsonObject) + (NUMBER_OF_ELEMENTS) * sizeof(JsonObject::node_type) + \
+   JSON_OBJECT_INDEX_SIZE(NUMBER_OF_ELEMENTS))
+
+// Returns the maximum size (in bytes) of the index of an object with n
+// elements, see ARDUINOJSON_OBJECT_INDEX_THRESHOLD.
+// The hash table has up to four slots per element, and grows by doubling.
+#define JSON_OBJECT_INDEX_SIZE(NUMBER_OF_ELEMENTS)                 \
+  (ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0 &&                       \
+           (NUMBER_OF_ELEMENTS) > ARDUINOJSON_OBJECT_INDEX_THRESHOLD \
+       ? 8 * ((NUMBER_OF_ELEMENTS) + 4) * sizeof(void *)            \
+       : 0)
 
 namespace ArduinoJson {
 
@@ -37,6 +49,12 @@ class JsonObjectSubscript;
 // JsonBuffer::createObject() or JsonBuffer::parseObject().
 // A JsonObject can be serialized to a JSON string via JsonObject::printTo().
 // It can also be deserialized from a JSON string via JsonBuffer::parseObject().
+//
+// Once an object has more than ARDUINOJSON_OBJECT_INDEX_THRESHOLD members, it
+// keeps a hash table of the keys in the JsonBuffer, so the lookups don't
+// compare the key with every member.
+// CAUTION: the table doesn't see the keys changed through an iterator; to
+// rename a member of a large object, remove it and add it again.
 class JsonObject : public Internals::JsonPrintable<JsonObject>,
                    public Internals::ReferenceType,
                    public Internals::NonCopyable,
@@ -47,7 +65,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   // You should not use this constructor directly.
   // Instead, use JsonBuffer::createObject() or JsonBuffer.parseObject().
   explicit JsonObject(JsonBuffer* buffer) throw()
-      : Internals::List<JsonPair>(buffer) {}
+      : Internals::List<JsonPair>(buffer) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0
+    _index = NULL;
+#endif
+  }
 
   // Gets or sets the value associated with the specified key.
   //
@@ -251,7 +273,52 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   }
   //
   // void remove(iterator)
-  using Internals::List<JsonPair>::remove;
+  void remove(iterator it) {
+    if (it == end()) return;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0
+    node_type* duplicate = NULL;
+    if (_index && unindexNode(&*it)) {
+      // another member with the same key must take its place in the index
+      for (node_type* node = firstNode(); node; node = node->next) {
+        if (&node->content != &*it && equals(node->content.key, it->key)) {
+          duplicate = node;
+          break;
+        }
+      }
+    }
+    Internals::List<JsonPair>::remove(it);
+    if (duplicate) indexNode(duplicate);
+#else
+    Internals::List<JsonPair>::remove(it);
+#endif
+  }
+
+  // Adds a member with the specified key at the end of the object, without
+  // looking for the key, and updates the index.
+  // The key is not duplicated, so it must remain valid.
+  // Returns end() if the allocation failed.
+  iterator addNode(const char* key) {
+    iterator it = Internals::List<JsonPair>::add();
+    if (it == end()) return it;
+    it->key = key;
+    indexLastNode();
+    return it;
+  }
+
+  // Tells if the index must grow when the object reaches the specified size;
+  // if so, updates its capacity and returns the number of bytes allocated.
+  // Used by JsonVariant::compactSize().
+  static size_t growIndex(size_t size, size_t& capacity) {
+    const size_t threshold = ARDUINOJSON_OBJECT_INDEX_THRESHOLD;
+    if (threshold == 0 || size <= threshold || 2 * size <= capacity) return 0;
+    if (capacity == 0) {
+      capacity = 1;
+      while (capacity < 2 * size) capacity *= 2;
+    } else {
+      capacity *= 2;
+    }
+    return indexSize(capacity);
+  }
 
   // Returns a reference an invalid JsonObject.
   // This object is meant to replace a NULL pointer.
@@ -262,9 +329,30 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   }
 
  private:
+  // An open-addressing hash table of the nodes, with linear probing.
+  // When a key appears several times, only the first node is in the table,
+  // as it's the one the linear search would find.
+  struct Index {
+    size_t capacity;  // a power of two, at least twice the count
+    size_t count;
+    node_type* slots[1];  // followed by the other slots
+  };
+
   // Returns the list node that matches the specified key.
   template <typename TStringRef>
   iterator findKey(TStringRef key) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0
+    if (_index && !Internals::StringTraits<TStringRef>::is_null(key)) {
+      size_t mask = _index->capacity - 1;
+      for (size_t i = hash<TStringRef>(key) & mask; _index->slots[i];
+           i = (i + 1) & mask) {
+        node_type* node = _index->slots[i];
+        if (Internals::StringTraits<TStringRef>::equals(key, node->content.key))
+          return iterator(node);
+      }
+      return end();
+    }
+#endif
     iterator it;
     for (it = begin(); it != end(); ++it) {
       if (Internals::StringTraits<TStringRef>::equals(key, it->key)) break;
@@ -295,9 +383,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
       // add the key
       it = Internals::List<JsonPair>::add();
       if (it == end()) return false;
+      it->key = NULL;
       bool key_ok =
           Internals::ValueSaver<TStringRef>::save(_buffer, it->key, key);
       if (!key_ok) return false;
+      indexLastNode();
     }
 
     // save the value
@@ -315,6 +405,94 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
 
   template <typename TStringRef>
   JsonObject& createNestedObject_impl(TStringRef key);
+
+  // FNV-1a
+  template <typename TStringRef>
+  static uint32_t hash(TStringRef key) {
+    typename Internals::StringTraits<TStringRef>::Reader reader(key);
+    uint32_t h = 2166136261u;
+    for (; reader.current(); reader.move()) {
+      h ^= static_cast<uint8_t>(reader.current());
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  static bool equals(const char* a, const char* b) {
+    return Internals::StringTraits<const char*>::equals(a, b);
+  }
+
+  static size_t indexSize(size_t capacity) {
+    return sizeof(Index) + (capacity - 1) * sizeof(node_type*);
+  }
+
+  // Creates or grows the index if needed, then adds the last node
+  void indexLastNode() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0
+    size_t capacity = _index ? _index->capacity : 0;
+    if (growIndex(size(), capacity) && !rehash(capacity)) return;
+    if (_index) indexNode(lastNode());
+#endif
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD > 0
+  // Replaces the index by a table of the specified capacity.
+  // If it can't be allocated, the object is not indexed anymore.
+  bool rehash(size_t capacity) {
+    Index* newIndex = static_cast<Index*>(_buffer->alloc(indexSize(capacity)));
+    if (_index) _buffer->release(_index, indexSize(_index->capacity));
+    _index = newIndex;
+    if (!newIndex) return false;
+    newIndex->capacity = capacity;
+    newIndex->count = 0;
+    for (size_t i = 0; i < capacity; i++) newIndex->slots[i] = NULL;
+    for (node_type* node = firstNode(); node; node = node->next) {
+      indexNode(node);
+    }
+    return true;
+  }
+
+  // Adds the node to the index, unless its key is already there
+  void indexNode(node_type* node) {
+    const char* key = node->content.key;
+    if (!key) return;
+    size_t mask = _index->capacity - 1;
+    size_t i = hash<const char*>(key) & mask;
+    for (; _index->slots[i]; i = (i + 1) & mask) {
+      if (equals(key, _index->slots[i]->content.key)) return;
+    }
+    _index->slots[i] = node;
+    _index->count++;
+  }
+
+  // Removes the node of the specified pair from the index.
+  // Returns false if it wasn't there.
+  bool unindexNode(const JsonPair* pair) {
+    if (!pair->key) return false;
+    size_t mask = _index->capacity - 1;
+    size_t i = hash<const char*>(pair->key) & mask;
+    while (_index->slots[i] && &_index->slots[i]->content != pair)
+      i = (i + 1) & mask;
+    if (!_index->slots[i]) return false;
+
+    // shift back the following nodes that can't be reached anymore
+    _index->slots[i] = NULL;
+    _index->count--;
+    for (size_t j = (i + 1) & mask; _index->slots[j]; j = (j + 1) & mask) {
+      size_t home = hash<const char*>(_index->slots[j]->content.key) & mask;
+      // move the node unless its home slot is in the range (i, j]
+      bool reachable =
+          i < j ? (home > i && home <= j) : (home > i || home <= j);
+      if (reachable) continue;
+      _index->slots[i] = _index->slots[j];
+      _index->slots[j] = NULL;
+      i = j;
+    }
+    return true;
+  }
+
+  Index* _index;
+#endif
 };
 
 namespace Internals {
@@ -59,6 +59,11 @@ class JsonObjectSubscript
     return _object.get<TValue>(_key);
   }
 
+  template <typename TValue>
+  FORCE_INLINE bool as(TValue& value) const {
+    return _object.get<JsonVariant>(_key).as(value);
+  }
+
   template <typename TValue>
   FORCE_INLINE bool is() const {
     return _object.is<TValue>(_key);
@@ -0,0 +1,323 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include "Configuration.hpp"
+#include "Data/Encoding.hpp"
+#include "Data/NonCopyable.hpp"
+#include "Deserialization/JsonChars.hpp"
+#include "JsonArray.hpp"
+#include "JsonObject.hpp"
+#include "JsonVariant.hpp"
+#include "RawJson.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+// The statuses don't depend on the template parameters of JsonPushParser
+struct JsonPushParserBase {
+  enum Status { NEED_MORE_DATA, COMPLETE, PARSE_ERROR };
+};
+}  // namespace Internals
+
+// A parser that receives the input in chunks, for example as it arrives from
+// the network, instead of pulling it from a reader:
+//
+//   DynamicJsonBuffer jsonBuffer;
+//   JsonPushParser<DynamicJsonBuffer> parser(jsonBuffer);
+//   while (parser.feed(chunk, chunkSize) == parser.NEED_MORE_DATA) { ... }
+//   JsonObject& root = parser.root();
+//
+// The parser never blocks: it consumes the chunk, saves its state, and
+// returns. The nesting is stored in an explicit stack of NESTING_LIMIT levels,
+// so the memory usage is fixed.
+// The accepted syntax and the resulting tree are the same as with
+// JsonBuffer::parse().
+//
+// CAUTION: the JsonBuffer must not be used for anything else until the
+// parsing is complete, because the current string is allocated in place.
+template <typename TJsonBuffer,
+          size_t NESTING_LIMIT = ARDUINOJSON_DEFAULT_NESTING_LIMIT>
+class JsonPushParser : public Internals::JsonPushParserBase,
+                       Internals::NonCopyable {
+  typedef typename TJsonBuffer::String String;
+
+ public:
+  JsonPushParser(TJsonBuffer& buffer)
+      : _buffer(&buffer),
+        _string(buffer.startString()),
+        _status(NEED_MORE_DATA),
+        _lexer(BETWEEN_TOKENS),
+        _expected(VALUE),
+        _depth(0),
+        _quote(0),
+        _isKey(false) {}
+
+  // Consumes a chunk of the input.
+  // Returns NEED_MORE_DATA until the root value is complete; the bytes that
+  // follow it are ignored.
+  Status feed(const char* data, size_t length) {
+    for (size_t i = 0; i < length && _status == NEED_MORE_DATA; i++)
+      process(data[i]);
+    return _status;
+  }
+
+  // Signals the end of the input, which terminates a root value that isn't
+  // delimited, like a number.
+  Status finish() {
+    if (_status == NEED_MORE_DATA) process('\0');
+    if (_status == NEED_MORE_DATA) _status = PARSE_ERROR;
+    return _status;
+  }
+
+  Status status() const {
+    return _status;
+  }
+
+  // The root value, valid once the status is COMPLETE
+  JsonVariant root() const {
+    return _root;
+  }
+
+ private:
+  enum LexerState {
+    BETWEEN_TOKENS,
+    IN_QUOTED_STRING,
+    IN_ESCAPE_SEQUENCE,
+    IN_NON_QUOTED_STRING,
+    AFTER_SLASH,
+    IN_BLOCK_COMMENT,
+    AFTER_STAR_IN_BLOCK_COMMENT,
+    IN_LINE_COMMENT
+  };
+
+  enum ExpectedToken {
+    VALUE,
+    VALUE_OR_CLOSING_BRACKET,
+    KEY,
+    KEY_OR_CLOSING_BRACE,
+    COLON,
+    COMMA_OR_CLOSING
+  };
+
+  struct Frame {
+    JsonArray* array;
+    JsonObject* object;
+    const char* key;
+  };
+
+  void process(char c) {
+    switch (_lexer) {
+      case IN_QUOTED_STRING:
+        if (c == '\0') break;  // unterminated string, like JsonParser
+        if (c == _quote) return endString(true);
+        if (c == '\\') {
+          _lexer = IN_ESCAPE_SEQUENCE;
+        } else {
+          _string.append(c);
+        }
+        return;
+
+      case IN_ESCAPE_SEQUENCE:
+        if (c == '\0') break;
+        _string.append(Internals::Encoding::unescapeChar(c));
+        _lexer = IN_QUOTED_STRING;
+        return;
+
+      case IN_NON_QUOTED_STRING:
+        if (Internals::canBeInNonQuotedString(c)) {
+          _string.append(c);
+          return;
+        }
+        endString(false);
+        if (_status != NEED_MORE_DATA) return;
+        break;
+
+      case AFTER_SLASH:
+        _lexer = BETWEEN_TOKENS;
+        if (c == '*') {
+          _lexer = IN_BLOCK_COMMENT;
+          return;
+        }
+        if (c == '/') {
+          _lexer = IN_LINE_COMMENT;
+          return;
+        }
+        // not a comment, just a '/'
+        processToken('/');
+        if (_status != NEED_MORE_DATA) return;
+        break;
+
+      case IN_BLOCK_COMMENT:
+        if (c == '*') _lexer = AFTER_STAR_IN_BLOCK_COMMENT;
+        if (c != '\0') return;
+        break;
+
+      case AFTER_STAR_IN_BLOCK_COMMENT:
+        if (c == '/') {
+          _lexer = BETWEEN_TOKENS;
+          return;
+        }
+        if (c != '*') _lexer = IN_BLOCK_COMMENT;
+        if (c != '\0') return;
+        break;
+
+      case IN_LINE_COMMENT:
+        if (c != '\n' && c != '\0') return;
+        break;
+
+      case BETWEEN_TOKENS:
+        break;
+    }
+
+    if (_lexer == IN_QUOTED_STRING || _lexer == IN_ESCAPE_SEQUENCE) {
+      endString(true);
+      if (_status != NEED_MORE_DATA) return;
+    }
+    _lexer = BETWEEN_TOKENS;
+
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        return;
+
+      case '/':
+        _lexer = AFTER_SLASH;
+        return;
+
+      default:
+        processToken(c);
+    }
+  }
+
+  // Handles the first char of a token, the spaces and comments being skipped
+  void processToken(char c) {
+    switch (_expected) {
+      case VALUE_OR_CLOSING_BRACKET:
+        if (c == ']') return endContainer();
+      // fall through
+      case VALUE:
+        return startValue(c);
+
+      case KEY_OR_CLOSING_BRACE:
+        if (c == '}') return endContainer();
+      // fall through
+      case KEY:
+        return startString(c, true);
+
+      case COLON:
+        if (c != ':') return fail();
+        _expected = VALUE;
+        return;
+
+      case COMMA_OR_CLOSING:
+        if (c == ',') {
+          _expected = top().object ? KEY : VALUE;
+          return;
+        }
+        if (c != (top().object ? '}' : ']')) return fail();
+        return endContainer();
+    }
+  }
+
+  void startValue(char c) {
+    switch (c) {
+      case '[':
+        if (_depth == NESTING_LIMIT) return fail();
+        _stack[_depth].array = &_buffer->createArray();
+        _stack[_depth].object = NULL;
+        if (!_stack[_depth].array->success()) return fail();
+        _depth++;
+        _expected = VALUE_OR_CLOSING_BRACKET;
+        return;
+
+      case '{':
+        if (_depth == NESTING_LIMIT) return fail();
+        _stack[_depth].array = NULL;
+        _stack[_depth].object = &_buffer->createObject();
+        if (!_stack[_depth].object->success()) return fail();
+        _depth++;
+        _expected = KEY_OR_CLOSING_BRACE;
+        return;
+
+      default:
+        return startString(c, false);
+    }
+  }
+
+  void startString(char c, bool isKey) {
+    _string = _buffer->startString();
+    _isKey = isKey;
+    if (Internals::isQuote(c)) {
+      _quote = c;
+      _lexer = IN_QUOTED_STRING;
+    } else if (Internals::canBeInNonQuotedString(c)) {
+      _string.append(c);
+      _lexer = IN_NON_QUOTED_STRING;
+    } else {
+      // an empty non-quoted string, c still needs to be processed
+      endString(false);
+      if (_status == NEED_MORE_DATA) processToken(c);
+    }
+  }
+
+  void endString(bool hasQuotes) {
+    _lexer = BETWEEN_TOKENS;
+    const char* s = _string.c_str();
+    if (!s) return fail();
+    if (_isKey) {
+      top().key = s;
+      _expected = COLON;
+    } else if (hasQuotes) {
+      addValue(s);
+    } else {
+      addValue(RawJson(s));
+    }
+  }
+
+  void endContainer() {
+    Frame& frame = _stack[--_depth];
+    if (frame.array)
+      addValue(*frame.array);
+    else
+      addValue(*frame.object);
+  }
+
+  void addValue(const JsonVariant& value) {
+    if (_depth == 0) {
+      _root = value;
+      _status = COMPLETE;
+      return;
+    }
+    Frame& frame = top();
+    bool ok = frame.array ? frame.array->add(value)
+                          : frame.object->set(frame.key, value);
+    if (!ok) return fail();
+    _expected = COMMA_OR_CLOSING;
+  }
+
+  void fail() {
+    _status = PARSE_ERROR;
+  }
+
+  Frame& top() {
+    return _stack[_depth - 1];
+  }
+
+  TJsonBuffer* _buffer;
+  String _string;
+  JsonVariant _root;
+  Status _status;
+  LexerState _lexer;
+  ExpectedToken _expected;
+  size_t _depth;
+  char _quote;
+  bool _isKey;
+  Frame _stack[NESTING_LIMIT];
+};
+}  // namespace ArduinoJson
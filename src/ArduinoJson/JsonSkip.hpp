@@ -0,0 +1,52 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Configuration.hpp"
+#include "Deserialization/SkipValue.hpp"
+
+namespace ArduinoJson {
+
+// Skips the JSON value at the beginning of the string, with the same rules as
+// JsonBuffer::parse(), but without allocating anything.
+//
+// Returns a pointer to the char that follows the value, or NULL if the value
+// is invalid or nested deeper than the nesting limit.
+inline const char *skipJson(
+    const char *json,
+    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  if (!json) return NULL;
+  return Internals::skipValue(json, nestingLimit);
+}
+
+// Finds an element of the JSON array at the beginning of the string, by
+// skipping the elements that precede it.
+// This allows to parse a single element of a large array:
+//
+//   JsonObject& item = jsonBuffer.parseObject(findJsonElement(json, 1000));
+//
+// Returns a pointer to the first char of the element, or NULL if the array is
+// invalid or too short.
+inline const char *findJsonElement(
+    const char *json, size_t index,
+    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  using namespace Internals;
+  if (!json || nestingLimit == 0) return NULL;
+
+  const char *s = skipSpacesAndComments(json);
+  if (*s != '[') return NULL;
+  s = skipSpacesAndComments(s + 1);
+  if (*s == ']') return NULL;
+
+  for (; index > 0; index--) {
+    s = skipValue(s, uint8_t(nestingLimit - 1));
+    if (!s) return NULL;
+    s = skipSpacesAndComments(s);
+    if (*s != ',') return NULL;
+    s = skipSpacesAndComments(s + 1);
+  }
+  return s;
+}
+}  // namespace ArduinoJson
@@ -7,7 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>  // for uint8_t
 
-#include "Data/JsonVariantContent.hpp"
+#include "Data/JsonVariantData.hpp"
 #include "Data/JsonVariantDefault.hpp"
 #include "Data/JsonVariantType.hpp"
 #include "JsonVariantBase.hpp"
@@ -27,6 +27,7 @@ namespace ArduinoJson {
 
 // Forward declarations.
 class JsonArray;
+class JsonBuffer;
 class JsonObject;
 
 // A variant that can be a any value serializable to a JSON value.
@@ -42,14 +43,15 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
 
  public:
   // Creates an uninitialized JsonVariant
-  JsonVariant() : _type(Internals::JSON_UNDEFINED) {}
+  JsonVariant() {
+    _data.setUndefined();
+  }
 
   // Create a JsonVariant containing a boolean value.
   // It will be serialized as "true" or "false" in JSON.
   JsonVariant(bool value) {
     using namespace Internals;
-    _type = JSON_BOOLEAN;
-    _content.asInteger = static_cast<JsonUInt>(value);
+    _data.setInteger(JSON_BOOLEAN, static_cast<JsonUInt>(value));
   }
 
   // Create a JsonVariant containing a floating point value.
@@ -58,18 +60,14 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
   template <typename T>
   JsonVariant(T value, typename Internals::EnableIf<
                            Internals::IsFloatingPoint<T>::value>::type * = 0) {
-    using namespace Internals;
-    _type = JSON_FLOAT;
-    _content.asFloat = static_cast<JsonFloat>(value);
+    _data.setFloat(static_cast<Internals::JsonFloat>(value));
   }
   template <typename T>
   DEPRECATED("Second argument is not supported anymore")
   JsonVariant(T value, uint8_t,
               typename Internals::EnableIf<
                   Internals::IsFloatingPoint<T>::value>::type * = 0) {
-    using namespace Internals;
-    _type = JSON_FLOAT;
-    _content.asFloat = static_cast<JsonFloat>(value);
+    _data.setFloat(static_cast<Internals::JsonFloat>(value));
   }
 
   // Create a JsonVariant containing an integer value.
@@ -86,11 +84,9 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
           0) {
     using namespace Internals;
     if (value >= 0) {
-      _type = JSON_POSITIVE_INTEGER;
-      _content.asInteger = static_cast<JsonUInt>(value);
+      _data.setInteger(JSON_POSITIVE_INTEGER, static_cast<JsonUInt>(value));
     } else {
-      _type = JSON_NEGATIVE_INTEGER;
-      _content.asInteger = static_cast<JsonUInt>(-value);
+      _data.setInteger(JSON_NEGATIVE_INTEGER, static_cast<JsonUInt>(-value));
     }
   }
   // JsonVariant(unsigned short)
@@ -101,8 +97,7 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
               typename Internals::EnableIf<
                   Internals::IsUnsignedIntegral<T>::value>::type * = 0) {
     using namespace Internals;
-    _type = JSON_POSITIVE_INTEGER;
-    _content.asInteger = static_cast<JsonUInt>(value);
+    _data.setInteger(JSON_POSITIVE_INTEGER, static_cast<JsonUInt>(value));
   }
 
   // Create a JsonVariant containing a string.
@@ -114,14 +109,20 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
       const TChar *value,
       typename Internals::EnableIf<Internals::IsChar<TChar>::value>::type * =
           0) {
-    _type = Internals::JSON_STRING;
-    _content.asString = reinterpret_cast<const char *>(value);
+    _data.setString(Internals::JSON_STRING,
+                    reinterpret_cast<const char *>(value));
   }
 
   // Create a JsonVariant containing an unparsed string
   JsonVariant(Internals::RawJsonString<const char *> value) {
-    _type = Internals::JSON_UNPARSED;
-    _content.asString = value;
+    _data.setString(unparsedType(value), value);
+  }
+
+  // Create a JsonVariant containing a copy of a small string
+  JsonVariant(Internals::SmallString value) {
+    Internals::JsonVariantType type = value.type;
+    if (type == Internals::JSON_UNPARSED) type = unparsedType(value.value);
+    _data.setSmallString(type, value.value);
   }
 
   // Create a JsonVariant containing a reference to an array.
@@ -239,6 +240,20 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
     return *this;
   }
 
+  // Gets the variant as an integer, and tells whether the value is exact.
+  // Returns false, and leaves value unchanged, if the variant is not an
+  // integer (see is<T>()) or if it is out of the range of T, where as<T>()
+  // would return a wrapped value.
+  //
+  // bool as(int& value) const;
+  // bool as(long& value) const;
+  // bool as(unsigned long& value) const;
+  template <typename T>
+  typename Internals::EnableIf<Internals::IsIntegral<T>::value, bool>::type as(
+      T &value) const {
+    return variantAsInteger(value);
+  }
+
   // Tells weither the variant has the specified type.
   // Returns true if the variant has type type T, false otherwise.
   //
@@ -312,10 +327,26 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
 
   // Returns true if the variant has a value
   bool success() const {
-    return _type != Internals::JSON_UNDEFINED;
+    return _data.type() != Internals::JSON_UNDEFINED;
+  }
+
+  // Copies the value, with all its strings, arrays and objects, in a
+  // JsonBuffer.
+  // The copy takes exactly compactSize() bytes, and the nodes are allocated
+  // in traversal order.
+  // Returns an undefined JsonVariant if the JsonBuffer is too small.
+  JsonVariant compactInto(JsonBuffer &buffer) const;
+
+  // Returns the number of bytes allocated by compactInto()
+  size_t compactSize() const {
+    size_t size = 0;
+    addCompactSize(size);
+    return size;
   }
 
  private:
+  void addCompactSize(size_t &size) const;
+  bool hasString() const;
   JsonArray &variantAsArray() const;
   JsonObject &variantAsObject() const;
   const char *variantAsString() const;
@@ -323,26 +354,32 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
   T variantAsFloat() const;
   template <typename T>
   T variantAsInteger() const;
+  template <typename T>
+  bool variantAsInteger(T &value) const;
   bool variantIsBoolean() const;
   bool variantIsFloat() const;
   bool variantIsInteger() const;
   bool variantIsArray() const {
-    return _type == Internals::JSON_ARRAY;
+    return _data.type() == Internals::JSON_ARRAY;
   }
   bool variantIsObject() const {
-    return _type == Internals::JSON_OBJECT;
+    return _data.type() == Internals::JSON_OBJECT;
   }
   bool variantIsString() const {
-    return _type == Internals::JSON_STRING ||
-           (_type == Internals::JSON_UNPARSED && _content.asString &&
-            !strcmp("null", _content.asString));
+    Internals::JsonVariantType type = variantType();
+    return type == Internals::JSON_STRING ||
+           type == Internals::JSON_UNPARSED_NULL;
+  }
+  Internals::JsonVariantType variantType() const {
+    return _data.type();
   }
 
-  // The current type of the variant
-  Internals::JsonVariantType _type;
+  // Classifies an unparsed string when it's stored, so the conversions don't
+  // scan the text, and the const functions don't modify the variant.
+  static Internals::JsonVariantType unparsedType(const char *);
 
-  // The various alternatives for the value of the variant.
-  Internals::JsonVariantContent _content;
+  // The type and the value of the variant
+  Internals::JsonVariantData _data;
 };
 
 DEPRECATED("Decimal places are ignored, use the float value instead")
@@ -19,102 +19,228 @@ namespace ArduinoJson {
 
 inline JsonVariant::JsonVariant(const JsonArray &array) {
   if (array.success()) {
-    _type = Internals::JSON_ARRAY;
-    _content.asArray = const_cast<JsonArray *>(&array);
+    _data.setArray(const_cast<JsonArray *>(&array));
   } else {
-    _type = Internals::JSON_UNDEFINED;
+    _data.setUndefined();
   }
 }
 
 inline JsonVariant::JsonVariant(const JsonObject &object) {
   if (object.success()) {
-    _type = Internals::JSON_OBJECT;
-    _content.asObject = const_cast<JsonObject *>(&object);
+    _data.setObject(const_cast<JsonObject *>(&object));
   } else {
-    _type = Internals::JSON_UNDEFINED;
+    _data.setUndefined();
   }
 }
 
 inline JsonArray &JsonVariant::variantAsArray() const {
-  if (_type == Internals::JSON_ARRAY) return *_content.asArray;
+  if (_data.type() == Internals::JSON_ARRAY) return *_data.asArray();
   return JsonArray::invalid();
 }
 
 inline JsonObject &JsonVariant::variantAsObject() const {
-  if (_type == Internals::JSON_OBJECT) return *_content.asObject;
+  if (_data.type() == Internals::JSON_OBJECT) return *_data.asObject();
   return JsonObject::invalid();
 }
 
+inline Internals::JsonVariantType JsonVariant::unparsedType(const char *s) {
+  using namespace Internals;
+  JsonVariantType type = JSON_UNPARSED;
+  if (!s) {
+    type = JSON_UNPARSED_STRING;
+  } else if (!strcmp(s, "null")) {
+    type = JSON_UNPARSED_NULL;
+  } else if (!strcmp(s, "true") || !strcmp(s, "false")) {
+    type = JSON_UNPARSED_BOOLEAN;
+  } else if (isFloat(s)) {
+    type = isInteger(s) ? JSON_UNPARSED_INTEGER : JSON_UNPARSED_FLOAT;
+  } else if (!isInteger(s)) {
+    type = JSON_UNPARSED_STRING;
+  }
+  // a sign alone is an integer but not a float, so it remains unclassified
+  return type;
+}
+
+inline bool JsonVariant::hasString() const {
+  using namespace Internals;
+  JsonVariantType type = _data.type();
+  return (type == JSON_STRING || isUnparsed(type)) && _data.asString();
+}
+
+// Must allocate exactly like compactInto(), including the alignment
+inline void JsonVariant::addCompactSize(size_t &size) const {
+  using namespace Internals;
+  if (hasString()) {
+    const char *s = _data.asString();
+    if (!SmallString::fits(s)) {
+      size = JsonBuffer::round_size_up(size) + strlen(s) + 1;
+    }
+  } else if (_data.type() == JSON_ARRAY) {
+    size = JsonBuffer::round_size_up(size) + sizeof(JsonArray);
+    size_t indexCapacity = 0;
+    size_t position = 0;
+    const JsonArray &array = *_data.asArray();
+    for (JsonArray::const_iterator it = array.begin(); it != array.end();
+         ++it, position++) {
+      size = JsonBuffer::round_size_up(size) + sizeof(JsonArray::node_type);
+      size_t indexSize = JsonArray::growIndex(position, indexCapacity);
+      if (indexSize) size = JsonBuffer::round_size_up(size) + indexSize;
+      it->addCompactSize(size);
+    }
+  } else if (_data.type() == JSON_OBJECT) {
+    size = JsonBuffer::round_size_up(size) + sizeof(JsonObject);
+    size_t indexCapacity = 0;
+    size_t count = 0;
+    const JsonObject &object = *_data.asObject();
+    for (JsonObject::const_iterator it = object.begin(); it != object.end();
+         ++it) {
+      if (it->key) {
+        size = JsonBuffer::round_size_up(size) + strlen(it->key) + 1;
+      }
+      size = JsonBuffer::round_size_up(size) + sizeof(JsonObject::node_type);
+      size_t indexSize = JsonObject::growIndex(++count, indexCapacity);
+      if (indexSize) size = JsonBuffer::round_size_up(size) + indexSize;
+      it->value.addCompactSize(size);
+    }
+  }
+}
+
+inline JsonVariant JsonVariant::compactInto(JsonBuffer &buffer) const {
+  using namespace Internals;
+  JsonVariant copy = *this;
+
+  if (hasString()) {
+    const char *s = _data.asString();
+    if (SmallString::fits(s)) {
+      copy._data.setSmallString(_data.type(), s);
+    } else {
+      s = StringTraits<const char *>::duplicate(s, &buffer);
+      if (!s) return JsonVariant();
+      copy._data.setString(_data.type(), s);
+    }
+  } else if (_data.type() == JSON_ARRAY) {
+    JsonArray &array = buffer.createArray();
+    if (!array.success()) return JsonVariant();
+    const JsonArray &source = *_data.asArray();
+    for (JsonArray::const_iterator it = source.begin(); it != source.end();
+         ++it) {
+      JsonArray::iterator node = array.addNode();
+      if (node == array.end()) return JsonVariant();
+      *node = it->compactInto(buffer);
+      if (!node->success() && it->success()) return JsonVariant();
+    }
+    copy._data.setArray(&array);
+  } else if (_data.type() == JSON_OBJECT) {
+    JsonObject &object = buffer.createObject();
+    if (!object.success()) return JsonVariant();
+    const JsonObject &source = *_data.asObject();
+    for (JsonObject::const_iterator it = source.begin(); it != source.end();
+         ++it) {
+      const char *key = StringTraits<const char *>::duplicate(it->key, &buffer);
+      if (!key && it->key) return JsonVariant();
+      JsonObject::iterator node = object.addNode(key);
+      if (node == object.end()) return JsonVariant();
+      node->value = it->value.compactInto(buffer);
+      if (!node->value.success() && it->value.success()) return JsonVariant();
+    }
+    copy._data.setObject(&object);
+  }
+
+  return copy;
+}
+
 template <typename T>
 inline T JsonVariant::variantAsInteger() const {
   using namespace Internals;
-  switch (_type) {
+  switch (_data.type()) {
     case JSON_UNDEFINED:
       return 0;
     case JSON_POSITIVE_INTEGER:
     case JSON_BOOLEAN:
-      return T(_content.asInteger);
+      return T(_data.asInteger());
     case JSON_NEGATIVE_INTEGER:
-      return T(~_content.asInteger + 1);
+      return T(~_data.asInteger() + 1);
+    case JSON_UNPARSED_NULL:
+      return 0;
     case JSON_STRING:
     case JSON_UNPARSED:
-      return parseInteger<T>(_content.asString);
+    case JSON_UNPARSED_BOOLEAN:
+    case JSON_UNPARSED_INTEGER:
+    case JSON_UNPARSED_FLOAT:
+    case JSON_UNPARSED_STRING:
+      return parseInteger<T>(_data.asString());
+    default:
+      return T(_data.asFloat());
+  }
+}
+
+template <typename T>
+inline bool JsonVariant::variantAsInteger(T &value) const {
+  using namespace Internals;
+  switch (variantType()) {
+    case JSON_POSITIVE_INTEGER:
+      return convertInteger(_data.asInteger(), false, value);
+    case JSON_NEGATIVE_INTEGER:
+      return convertInteger(_data.asInteger(), true, value);
+    case JSON_UNPARSED_INTEGER:
+      return parseInteger(_data.asString(), value);
     default:
-      return T(_content.asFloat);
+      return false;
   }
 }
 
 inline const char *JsonVariant::variantAsString() const {
   using namespace Internals;
-  if (_type == JSON_UNPARSED && _content.asString &&
-      !strcmp("null", _content.asString))
-    return NULL;
-  if (_type == JSON_STRING || _type == JSON_UNPARSED) return _content.asString;
+  JsonVariantType type = variantType();
+  if (type == JSON_STRING) return _data.asString();
+  if (isUnparsed(type) && type != JSON_UNPARSED_NULL) return _data.asString();
   return NULL;
 }
 
 template <typename T>
 inline T JsonVariant::variantAsFloat() const {
   using namespace Internals;
-  switch (_type) {
+  switch (_data.type()) {
     case JSON_UNDEFINED:
       return 0;
     case JSON_POSITIVE_INTEGER:
     case JSON_BOOLEAN:
-      return static_cast<T>(_content.asInteger);
+      return static_cast<T>(_data.asInteger());
     case JSON_NEGATIVE_INTEGER:
-      return -static_cast<T>(_content.asInteger);
+      return -static_cast<T>(_data.asInteger());
     case JSON_STRING:
     case JSON_UNPARSED:
-      return parseFloat<T>(_content.asString);
+    case JSON_UNPARSED_NULL:
+    case JSON_UNPARSED_BOOLEAN:
+    case JSON_UNPARSED_INTEGER:
+    case JSON_UNPARSED_FLOAT:
+    case JSON_UNPARSED_STRING:
+      return parseFloat<T>(_data.asString());
     default:
-      return static_cast<T>(_content.asFloat);
+      return static_cast<T>(_data.asFloat());
   }
 }
 
 inline bool JsonVariant::variantIsBoolean() const {
   using namespace Internals;
-  if (_type == JSON_BOOLEAN) return true;
-
-  if (_type != JSON_UNPARSED || _content.asString == NULL) return false;
-
-  return !strcmp(_content.asString, "true") ||
-         !strcmp(_content.asString, "false");
+  JsonVariantType type = variantType();
+  return type == JSON_BOOLEAN || type == JSON_UNPARSED_BOOLEAN;
 }
 
 inline bool JsonVariant::variantIsInteger() const {
   using namespace Internals;
-
-  return _type == JSON_POSITIVE_INTEGER || _type == JSON_NEGATIVE_INTEGER ||
-         (_type == JSON_UNPARSED && isInteger(_content.asString));
+  JsonVariantType type = variantType();
+  return type == JSON_POSITIVE_INTEGER || type == JSON_NEGATIVE_INTEGER ||
+         type == JSON_UNPARSED_INTEGER ||
+         (type == JSON_UNPARSED && isInteger(_data.asString()));
 }
 
 inline bool JsonVariant::variantIsFloat() const {
   using namespace Internals;
-
-  return _type == JSON_FLOAT || _type == JSON_POSITIVE_INTEGER ||
-         _type == JSON_NEGATIVE_INTEGER ||
-         (_type == JSON_UNPARSED && isFloat(_content.asString));
+  JsonVariantType type = variantType();
+  return type == JSON_FLOAT || type == JSON_POSITIVE_INTEGER ||
+         type == JSON_NEGATIVE_INTEGER || type == JSON_UNPARSED_INTEGER ||
+         type == JSON_UNPARSED_FLOAT;
 }
 
 #if ARDUINOJSON_ENABLE_STD_STREAM
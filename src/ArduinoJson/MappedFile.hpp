@@ -0,0 +1,91 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Configuration.hpp"
+
+#if ARDUINOJSON_ENABLE_MMAP
+
+#include <fcntl.h>
+#include <stddef.h>  // for size_t
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Data/NonCopyable.hpp"
+
+namespace ArduinoJson {
+
+// A read-only file mapped in memory, that can be passed directly to
+// JsonBuffer::parse(), parseArray() and parseObject():
+//
+//   MappedFile file("config.json");
+//   JsonObject& root = jsonBuffer.parseObject(file);
+//
+// The strings are copied in the JsonBuffer, so the file can be closed as soon
+// as the parsing is done.
+class MappedFile : Internals::NonCopyable {
+ public:
+  explicit MappedFile(const char* path)
+      : _data(NULL), _size(0), _mappedSize(0) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0) map(fd, static_cast<size_t>(st.st_size));
+    close(fd);
+  }
+
+  ~MappedFile() {
+    if (_data) munmap(_data, _mappedSize);
+  }
+
+  // Tells if the file was successfully mapped
+  bool success() const {
+    return _data != NULL;
+  }
+
+  // Returns the content of the file, followed by a null terminator, or NULL
+  // if the file couldn't be mapped
+  const char* c_str() const {
+    return static_cast<const char*>(_data);
+  }
+
+  // Returns the size of the file, not counting the terminator
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  void map(int fd, size_t size) {
+    // Reserve at least one more byte than the file, so the content is always
+    // followed by a zero, even if the size is a multiple of the page size.
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t mappedSize = (size / pageSize + 1) * pageSize;
+    void* data =
+        mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (data == MAP_FAILED) return;
+
+    if (size > 0) {
+      // replace the beginning of the anonymous mapping by the file
+      if (mmap(data, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+          MAP_FAILED) {
+        munmap(data, mappedSize);
+        return;
+      }
+      madvise(data, size, MADV_SEQUENTIAL);
+    }
+
+    _data = data;
+    _size = size;
+    _mappedSize = mappedSize;
+  }
+
+  void* _data;
+  size_t _size;
+  size_t _mappedSize;
+};
+}  // namespace ArduinoJson
+
+#endif
@@ -0,0 +1,57 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+namespace ArduinoJson {
+
+// The parsing policies can be passed as the template argument of
+// JsonBuffer::parse(), parseArray() and parseObject(), for example:
+//
+//   JsonObject& root = jsonBuffer.parseObject<StructuralIndexParsing>(json);
+
+// The recursive-descent parser, used when no policy is specified.
+// It reads the input one token at a time, so it works with every kind of input.
+struct DefaultParsing {
+  static const bool use_structural_index = false;
+  static const bool eager_typing = false;
+  static const bool check_duplicate_keys = true;
+};
+
+// A two-stage parser for large documents in memory (char* and std::string):
+// it first locates all the structural chars of the input with bitmasks, then
+// builds the tree by walking this index.
+// It produces the same tree as the default parser, and falls back to it for
+// the inputs that contain comments or single quotes, or for the streams.
+// The index is allocated on the heap and released before the function returns.
+struct StructuralIndexParsing : DefaultParsing {
+  static const bool use_structural_index = true;
+};
+
+// Converts the numbers and the booleans when they are parsed, instead of
+// storing their text and converting it each time the value is read.
+// The integers are stored as JsonInteger or JsonUInt (unless they overflow),
+// the other numbers as JsonFloat; the text is not kept, so the serializer
+// prints the converted value, for example 100 for 1e2.
+// The flags can be combined in a policy of your own:
+//
+//   struct MyParsing : DefaultParsing {
+//     static const bool use_structural_index = true;
+//     static const bool eager_typing = true;
+//   };
+struct EagerTypingParsing : DefaultParsing {
+  static const bool eager_typing = true;
+};
+
+// Appends the members of the objects without looking for their keys, for the
+// inputs known to have unique keys, like the documents generated by a
+// program.
+// Without this search, parsing an object is O(n) instead of O(n^2) for the
+// objects that are not indexed (see ARDUINOJSON_OBJECT_INDEX_THRESHOLD).
+// If a key appears several times, all the members are kept, and the lookups
+// find the first one, whereas the default parser keeps only the last value.
+struct TrustedInputParsing : DefaultParsing {
+  static const bool check_duplicate_keys = false;
+};
+}  // namespace ArduinoJson
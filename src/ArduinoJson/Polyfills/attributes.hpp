@@ -9,6 +9,7 @@
 #define FORCE_INLINE  // __forceinline causes C4714 when returning std::string
 #define NO_INLINE __declspec(noinline)
 #define DEPRECATED(msg) __declspec(deprecated(msg))
+#define NO_SANITIZE_ADDRESS
 
 #elif defined(__GNUC__)  // GCC or Clang
 
@@ -19,11 +20,17 @@
 #else
 #define DEPRECATED(msg) __attribute__((deprecated))
 #endif
+#if defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)
+#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define NO_SANITIZE_ADDRESS
+#endif
 
 #else  // Other compilers
 
 #define FORCE_INLINE
 #define NO_INLINE
 #define DEPRECATED(msg)
+#define NO_SANITIZE_ADDRESS
 
 #endif
@@ -14,5 +14,9 @@ inline bool isdigit(char c) {
 inline bool issign(char c) {
   return '-' == c || c == '+';
 }
+
+inline bool isspace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
 }
 }
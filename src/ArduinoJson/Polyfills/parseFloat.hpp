@@ -4,18 +4,134 @@
 
 #pragma once
 
+#include "../Configuration.hpp"
 #include "../TypeTraits/FloatTraits.hpp"
+#include "./attributes.hpp"
 #include "./ctype.hpp"
 #include "./math.hpp"
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT
+#include "./computeFloat.hpp"
+#endif
+
 namespace ArduinoJson {
 namespace Internals {
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT
+// Reads the significand and the exponent of a positive decimal number.
+// The significant digits are passed to the accumulator, which tells if it
+// could store them.
+// Returns the power of ten by which the accumulator must be multiplied.
+template <typename TAccumulator>
+inline FORCE_INLINE int readDecimal(const char* s, TAccumulator& significand) {
+  int exponent = 0;
+
+  while (*s == '0') s++;
+  while (isdigit(*s)) {
+    if (!significand.append(*s)) exponent++;
+    s++;
+  }
+
+  if (*s == '.') {
+    s++;
+    if (significand.empty()) {
+      while (*s == '0') {
+        exponent--;
+        s++;
+      }
+    }
+    while (isdigit(*s)) {
+      if (significand.append(*s)) exponent--;
+      s++;
+    }
+  }
+
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    bool negative_exponent = *s == '-';
+    if (issign(*s)) s++;
+    int e = 0;
+    while (isdigit(*s)) {
+      if (e < 10000) e = e * 10 + (*s - '0');
+      s++;
+    }
+    exponent += negative_exponent ? -e : e;
+  }
+
+  return exponent;
+}
+
+// Keeps the first 19 digits, which fit in a uint64_t
+struct ShortSignificand {
+  uint64_t value;
+  int digits;
+  bool truncated;
+
+  ShortSignificand() : value(0), digits(0), truncated(false) {}
+
+  bool empty() const {
+    return digits == 0;
+  }
+
+  bool append(char c) {
+    if (digits == 19) {
+      if (c != '0') truncated = true;
+      return false;
+    }
+    value = value * 10 + uint64_t(c - '0');
+    digits++;
+    return true;
+  }
+};
+
+// Keeps enough digits to round any number
+struct LongSignificand {
+  BigInteger value;
+  int digits;
+  bool truncated;
+
+  LongSignificand() : value(0), digits(0), truncated(false) {}
+
+  bool empty() const {
+    return digits == 0;
+  }
+
+  bool append(char c) {
+    if (digits == 768) {
+      if (c != '0') truncated = true;
+      return false;
+    }
+    value.multiplyAdd(10, uint32_t(c - '0'));
+    digits++;
+    return true;
+  }
+};
+
+// Parses a positive number and returns the closest float
+template <typename T>
+inline T parseFloatExactly(const char* s) {
+  ShortSignificand significand;
+  int exponent = readDecimal(s, significand);
+  if (significand.value == 0) return 0;
+
+  T result = computeFloat<T>(significand.value, exponent);
+  if (!significand.truncated) return result;
+
+  // The dropped digits only matter if they change the rounding, which is
+  // rare enough to compare the number with the halfway point the slow way.
+  T upper = computeFloat<T>(significand.value + 1, exponent);
+  if (upper == result) return result;
+
+  LongSignificand longSignificand;
+  exponent = readDecimal(s, longSignificand);
+  return roundToNearest(longSignificand.value, exponent,
+                        longSignificand.truncated, result, upper);
+}
+#endif
+
 template <typename T>
 inline T parseFloat(const char* s) {
   typedef FloatTraits<T> traits;
-  typedef typename traits::mantissa_type mantissa_t;
-  typedef typename traits::exponent_type exponent_t;
 
   if (!s) return 0;  // NULL
 
@@ -35,6 +151,13 @@ inline T parseFloat(const char* s) {
   if (*s == 'i' || *s == 'I')
     return negative_result ? -traits::inf() : traits::inf();
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT
+  T result = parseFloatExactly<T>(s);
+  return negative_result ? -result : result;
+#else
+  typedef typename traits::mantissa_type mantissa_t;
+  typedef typename traits::exponent_type exponent_t;
+
   mantissa_t mantissa = 0;
   exponent_t exponent_offset = 0;
 
@@ -85,6 +208,7 @@ inline T parseFloat(const char* s) {
   T result = traits::make_float(static_cast<T>(mantissa), exponent);
 
   return negative_result ? -result : result;
+#endif
 }
 }
 }
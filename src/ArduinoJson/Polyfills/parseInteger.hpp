@@ -4,20 +4,128 @@
 
 #pragma once
 
+#include <limits.h>  // for CHAR_MIN
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>  // for memcpy
 
 #include "../Configuration.hpp"
+#include "../Data/JsonInteger.hpp"
+#include "../TypeTraits/IsSame.hpp"
+#include "../TypeTraits/IsSignedIntegral.hpp"
+#include "./attributes.hpp"
 #include "./ctype.hpp"
 
+// Eight digits can be loaded in a register, and converted with a few 64-bit
+// multiplications
+#if (defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ == 8 &&           \
+     defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_M_X64) || defined(_M_ARM64)
+#define ARDUINOJSON_SWAR_DIGITS 1
+#else
+#define ARDUINOJSON_SWAR_DIGITS 0
+#endif
+
 namespace ArduinoJson {
 namespace Internals {
+
+#if ARDUINOJSON_SWAR_DIGITS
+// Tells whether the 4 first chars of s are digits.
+// Stops at the first char that isn't, so it never reads past the terminator.
+inline FORCE_INLINE bool areFourDigits(const char *s) {
+  return isdigit(s[0]) && isdigit(s[1]) && isdigit(s[2]) && isdigit(s[3]);
+}
+
+// Converts 4 digits ("SIMD within a register"): each step merges the adjacent
+// numbers, from 4 numbers of 1 digit to 1 number of 4 digits.
+inline FORCE_INLINE uint32_t parseFourDigits(const char *s) {
+  uint32_t value;
+  memcpy(&value, s, 4);
+  value = ((value & 0x0F0F0F0F) * (10 << 8 | 1)) >> 8;
+  return ((value & 0x00FF00FF) * (100 << 16 | 1)) >> 16;
+}
+
+// Converts 8 digits, like parseFourDigits()
+inline FORCE_INLINE uint32_t parseEightDigits(const char *s) {
+  const uint64_t mask1 = 0x0F0F0F0F | uint64_t(0x0F0F0F0F) << 32;
+  const uint64_t mask2 = 0x00FF00FF | uint64_t(0x00FF00FF) << 32;
+  const uint64_t mask4 = 0x0000FFFF | uint64_t(0x0000FFFF) << 32;
+
+  uint64_t value;
+  memcpy(&value, s, 8);
+  value = ((value & mask1) * (10 << 8 | 1)) >> 8;
+  value = ((value & mask2) * (100 << 16 | 1)) >> 16;
+  return uint32_t(((value & mask4) * (uint64_t(10000) << 32 | 1)) >> 32);
+}
+#endif
+
+// Reads the digits at the beginning of s.
+// Sets overflow if the value doesn't fit in a JsonUInt, in which case it wraps
+// around.
+// Returns a pointer to the first char that is not a digit.
+inline FORCE_INLINE const char *parseDigits(const char *s, JsonUInt &value,
+                                            bool &overflow) {
+  // 19 digits (9 for a 32-bit JsonUInt) always fit, only the next ones need
+  // to be checked
+  int safeDigits = sizeof(JsonUInt) >= 8 ? 19 : 9;
+  value = 0;
+
+#if ARDUINOJSON_SWAR_DIGITS
+  while (safeDigits >= 4 && areFourDigits(s)) {
+    if (safeDigits < 8 || !areFourDigits(s + 4)) {
+      value = value * 10000 + parseFourDigits(s);
+      s += 4;
+      safeDigits -= 4;
+      break;
+    }
+    value = value * 100000000 + parseEightDigits(s);
+    s += 8;
+    safeDigits -= 8;
+  }
+#endif
+
+  for (; safeDigits > 0 && isdigit(*s); s++, safeDigits--) {
+    value = value * 10 + JsonUInt(*s - '0');
+  }
+
+  const JsonUInt max = JsonUInt(-1);
+  for (; isdigit(*s); s++) {
+    JsonUInt digit = JsonUInt(*s - '0');
+    if (value > (max - digit) / 10) overflow = true;
+    value = value * 10 + digit;
+  }
+
+  return s;
+}
+
+// Converts the magnitude and the sign of an integer to T.
+// Returns false if the value is out of the range of T.
+template <typename T>
+bool convertInteger(JsonUInt magnitude, bool negative, T &result) {
+  const bool isSigned = IsSignedIntegral<T>::value ||
+                        (IsSame<T, char>::value && CHAR_MIN < 0);
+  const JsonUInt max = isSigned ? (JsonUInt(1) << (sizeof(T) * 8 - 1)) - 1
+                                : JsonUInt(T(-1));
+
+  if (negative) {
+    if (magnitude > (isSigned ? max + 1 : 0)) return false;
+    result = T(~magnitude + 1);
+  } else {
+    if (magnitude > max) return false;
+    result = T(magnitude);
+  }
+  return true;
+}
+
+// Parses the integer at the beginning of s, like atoi().
+// The value wraps around if it doesn't fit in T.
 template <typename T>
 T parseInteger(const char *s) {
   if (!s) return 0;  // NULL
 
   if (*s == 't') return 1;  // "true"
 
-  T result = 0;
+  JsonUInt result;
   bool negative_result = false;
 
   switch (*s) {
@@ -30,12 +138,29 @@ T parseInteger(const char *s) {
       break;
   }
 
-  while (isdigit(*s)) {
-    result = T(result * 10 + T(*s - '0'));
-    s++;
-  }
+  bool overflow = false;
+  parseDigits(s, result, overflow);
+
+  return negative_result ? T(~result + 1) : T(result);
+}
+
+// Parses an integer that must fit in T.
+// Returns false, and leaves result unchanged, if s is not an integer (see
+// isInteger()) or if the value is out of the range of T.
+template <typename T>
+bool parseInteger(const char *s, T &result) {
+  if (!s) return false;
+
+  bool negative = *s == '-';
+  if (issign(*s)) s++;
+  if (!isdigit(*s)) return false;
+
+  JsonUInt magnitude;
+  bool overflow = false;
+  s = parseDigits(s, magnitude, overflow);
+  if (*s != '\0' || overflow) return false;
 
-  return negative_result ? T(~result + 1) : result;
+  return convertInteger(magnitude, negative, result);
 }
 }
 }
@@ -0,0 +1,171 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../Configuration.hpp"
+#include "./attributes.hpp"
+#include "./ctype.hpp"
+
+#if ARDUINOJSON_ENABLE_SIMD
+#ifdef __AVX2__
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace ArduinoJson {
+namespace Internals {
+
+#if ARDUINOJSON_ENABLE_SIMD
+
+// Thin wrapper on top of the SSE2 or AVX2 intrinsics.
+// A "mask" has one bit per byte of the block, the LSB being the first byte.
+struct Simd {
+#ifdef __AVX2__
+  typedef __m256i block_type;
+  static const uintptr_t block_size = 32;
+
+  // The aligned loads may read past the terminator, see scan()
+  NO_SANITIZE_ADDRESS static block_type load(const char* p) {
+    return _mm256_load_si256(
+        static_cast<const block_type*>(static_cast<const void*>(p)));
+  }
+
+  static uint32_t equals(block_type block, char c) {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c))));
+  }
+
+  static uint32_t all() {
+    return 0xFFFFFFFF;
+  }
+#else
+  typedef __m128i block_type;
+  static const uintptr_t block_size = 16;
+
+  // The aligned loads may read past the terminator, see scan()
+  NO_SANITIZE_ADDRESS static block_type load(const char* p) {
+    return _mm_load_si128(
+        static_cast<const block_type*>(static_cast<const void*>(p)));
+  }
+
+  static uint32_t equals(block_type block, char c) {
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c))));
+  }
+
+  static uint32_t all() {
+    return 0xFFFF;
+  }
+#endif
+
+  static int countTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+
+  // Returns a pointer to the first byte, at or after p, that is flagged by
+  // the stopper; a stopper must always flag the terminator.
+  //
+  // The loads are aligned on the size of the block, so they never cross a
+  // page boundary: we may read a few bytes past the terminator, but we never
+  // touch memory that isn't mapped.
+  template <typename TStopper>
+  static const char* scan(const char* p, TStopper stopper) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(p);
+    uintptr_t offset = address & (block_size - 1);
+    const char* block = reinterpret_cast<const char*>(address - offset);
+    uint32_t mask = stopper(load(block)) >> offset;
+    if (mask) return p + countTrailingZeros(mask);
+    for (;;) {
+      block += block_size;
+      mask = stopper(load(block));
+      if (mask) return block + countTrailingZeros(mask);
+    }
+  }
+};
+
+// Flags everything but spaces, tabs, and line breaks
+struct NonSpaceStopper {
+  uint32_t operator()(Simd::block_type block) const {
+    uint32_t spaces = Simd::equals(block, ' ') | Simd::equals(block, '\t') |
+                      Simd::equals(block, '\r') | Simd::equals(block, '\n');
+    return ~spaces & Simd::all();
+  }
+};
+
+// Flags the specified char and the terminator
+struct CharStopper {
+  CharStopper(char c) : _c(c) {}
+
+  uint32_t operator()(Simd::block_type block) const {
+    return Simd::equals(block, _c) | Simd::equals(block, '\0');
+  }
+
+ private:
+  char _c;
+};
+
+// Flags the two specified chars and the terminator
+struct TwoCharsStopper {
+  TwoCharsStopper(char c1, char c2) : _c1(c1), _c2(c2) {}
+
+  uint32_t operator()(Simd::block_type block) const {
+    return Simd::equals(block, _c1) | Simd::equals(block, _c2) |
+           Simd::equals(block, '\0');
+  }
+
+ private:
+  char _c1, _c2;
+};
+
+#endif
+
+// Returns a pointer to the first char of s that is not a space, a tab or a
+// line break.
+inline const char* skipSpaces(const char* s) {
+  if (!isspace(*s)) return s;
+#if ARDUINOJSON_ENABLE_SIMD
+  return Simd::scan(s + 1, NonSpaceStopper());
+#else
+  while (isspace(*s)) s++;
+  return s;
+#endif
+}
+
+// Returns a pointer to the first occurrence of c in s, or to the terminator if
+// c is not found.
+inline const char* findChar(const char* s, char c) {
+#if ARDUINOJSON_ENABLE_SIMD
+  return Simd::scan(s, CharStopper(c));
+#else
+  while (*s && *s != c) s++;
+  return s;
+#endif
+}
+
+// Returns a pointer to the first occurrence of c1 or c2 in s, or to the
+// terminator if neither is found.
+inline const char* findChar(const char* s, char c1, char c2) {
+#if ARDUINOJSON_ENABLE_SIMD
+  return Simd::scan(s, TwoCharsStopper(c1, c2));
+#else
+  while (*s && *s != c1 && *s != c2) s++;
+  return s;
+#endif
+}
+}  // namespace Internals
+}  // namespace ArduinoJson
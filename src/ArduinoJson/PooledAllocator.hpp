@@ -0,0 +1,323 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Configuration.hpp"
+
+#if ARDUINOJSON_ENABLE_THREAD_POOL
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "DynamicJsonBuffer.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic push
+#endif
+#pragma GCC diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+namespace ArduinoJson {
+
+// The statistics of one thread, see PooledAllocator::threadStats()
+struct PooledAllocatorStats {
+  size_t blocksCreated;   // blocks allocated with malloc()
+  size_t blocksReused;    // blocks taken from a free list
+  size_t blocksReleased;  // blocks returned to free()
+  size_t remoteFrees;     // blocks sent back to the thread that created them
+  size_t oversized;       // allocations larger than the largest block
+  size_t cachedBlocks;    // blocks in the free lists
+  size_t cachedBytes;     // bytes in the free lists
+};
+
+namespace Internals {
+// The free lists of one thread, one per size class.
+// Only the owner thread touches the first members; the other threads only
+// push to remoteFrees, which is on another cache line.
+template <size_t BLOCK_SIZE, size_t MAX_CACHED_BYTES>
+class PoolThreadCache {
+ public:
+  // The size classes are BLOCK_SIZE, 2*BLOCK_SIZE, 4*BLOCK_SIZE...
+  static const size_t size_classes = 8;
+
+  struct Header {
+    PoolThreadCache* owner;  // NULL for oversized allocations
+    union {
+      size_t sizeClass;  // when the block is in use
+      Header* next;      // when the block is in a free list
+    };
+  };
+
+  PoolThreadCache() : _references(1) {
+    PooledAllocatorStats empty = {0, 0, 0, 0, 0, 0, 0};
+    stats = empty;
+    for (size_t i = 0; i < size_classes; i++) {
+      _freeLists[i] = NULL;
+      _remoteFrees[i] = NULL;
+    }
+  }
+
+  static size_t blockSize(size_t sizeClass) {
+    return BLOCK_SIZE << sizeClass;
+  }
+
+  Header* allocate(size_t sizeClass) {
+    Header*& freeList = _freeLists[sizeClass];
+    if (!freeList &&
+        __atomic_load_n(&_remoteFrees[sizeClass], __ATOMIC_RELAXED)) {
+      adoptRemoteFrees(sizeClass);
+    }
+
+    Header* block = freeList;
+    if (block) {
+      freeList = block->next;
+      stats.cachedBlocks--;
+      stats.cachedBytes -= blockSize(sizeClass);
+      stats.blocksReused++;
+    } else {
+      block = static_cast<Header*>(malloc(blockSize(sizeClass)));
+      if (!block) return NULL;
+      block->owner = this;
+      __atomic_add_fetch(&_references, 1, __ATOMIC_RELAXED);
+      stats.blocksCreated++;
+    }
+    block->sizeClass = sizeClass;
+    return block;
+  }
+
+  // Called by the owner thread
+  void deallocate(Header* block) {
+    size_t sizeClass = block->sizeClass;
+    push(block, sizeClass);
+  }
+
+  // Called by any other thread, never blocks
+  void deallocateRemote(Header* block) {
+    Header** remoteFrees = &_remoteFrees[block->sizeClass];
+    Header* head = __atomic_load_n(remoteFrees, __ATOMIC_RELAXED);
+    do {
+      if (head == closed()) return release(block);
+      block->next = head;
+    } while (!__atomic_compare_exchange_n(remoteFrees, &head, block, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+  }
+
+  // Releases the blocks in the free lists
+  void trim() {
+    for (size_t i = 0; i < size_classes; i++) {
+      adoptRemoteFrees(i);
+      while (_freeLists[i]) {
+        Header* next = _freeLists[i]->next;
+        stats.blocksReleased++;
+        release(_freeLists[i]);
+        _freeLists[i] = next;
+      }
+    }
+    stats.cachedBlocks = 0;
+    stats.cachedBytes = 0;
+  }
+
+  // Called when the owner thread exits.
+  // The blocks still in use are released by the threads that free them, and
+  // the last one deletes the cache.
+  void close() {
+    trim();
+    for (size_t i = 0; i < size_classes; i++) {
+      Header* block =
+          __atomic_exchange_n(&_remoteFrees[i], closed(), __ATOMIC_ACQUIRE);
+      while (block) {
+        Header* next = block->next;
+        release(block);
+        block = next;
+      }
+    }
+    unreference();
+  }
+
+  PooledAllocatorStats stats;
+
+ private:
+  // Marks the remote free lists of a thread that exited
+  static Header* closed() {
+    return reinterpret_cast<Header*>(sizeof(Header));
+  }
+
+  void push(Header* block, size_t sizeClass) {
+    if (stats.cachedBytes + blockSize(sizeClass) > MAX_CACHED_BYTES) {
+      stats.blocksReleased++;
+      return release(block);
+    }
+    block->next = _freeLists[sizeClass];
+    _freeLists[sizeClass] = block;
+    stats.cachedBlocks++;
+    stats.cachedBytes += blockSize(sizeClass);
+  }
+
+  void adoptRemoteFrees(size_t sizeClass) {
+    Header* block = __atomic_exchange_n(
+        &_remoteFrees[sizeClass], static_cast<Header*>(NULL), __ATOMIC_ACQUIRE);
+    while (block) {
+      Header* next = block->next;
+      push(block, sizeClass);
+      block = next;
+    }
+  }
+
+  void release(Header* block) {
+    free(block);
+    unreference();
+  }
+
+  void unreference() {
+    if (__atomic_sub_fetch(&_references, 1, __ATOMIC_ACQ_REL) == 0) delete this;
+  }
+
+  // owned by the thread
+  Header* _freeLists[size_classes];
+  char _padding[64];
+
+  // shared with the other threads
+  Header* _remoteFrees[size_classes];
+  size_t _references;  // the blocks not released, plus one for the thread
+};
+}
+
+// An allocator for DynamicJsonBuffer that recycles blocks in per-thread free
+// lists, so that worker threads don't contend on malloc().
+// A block freed in another thread is sent back to the thread that created it,
+// without taking any lock.
+//
+// The blocks have fixed sizes: BLOCK_SIZE, 2*BLOCK_SIZE... up to
+// 128*BLOCK_SIZE; larger allocations go directly to malloc().
+// Each thread keeps up to MAX_CACHED_BYTES in its free lists.
+//
+// Use PooledJsonBuffer, whose blocks fill the size classes exactly.
+template <size_t BLOCK_SIZE = 4096, size_t MAX_CACHED_BYTES = 256 * 1024>
+class PooledAllocator {
+  typedef Internals::PoolThreadCache<BLOCK_SIZE, MAX_CACHED_BYTES> Cache;
+  typedef typename Cache::Header Header;
+
+ public:
+  // The size of the smallest blocks
+  static const size_t block_size = BLOCK_SIZE;
+
+  // The bytes added to each allocation
+  static const size_t overhead = sizeof(Header);
+
+  void* allocate(size_t size) {
+    size_t sizeClass = 0;
+    while (sizeClass < Cache::size_classes &&
+           Cache::blockSize(sizeClass) - overhead < size) {
+      sizeClass++;
+    }
+
+    Cache* cache = threadCache();
+    if (!cache) return NULL;
+
+    Header* block;
+    if (sizeClass < Cache::size_classes) {
+      block = cache->allocate(sizeClass);
+    } else {
+      block = static_cast<Header*>(malloc(overhead + size));
+      if (block) block->owner = NULL;
+      cache->stats.oversized++;
+    }
+    return block ? block + 1 : NULL;
+  }
+
+  void deallocate(void* pointer) {
+    if (!pointer) return;
+    Header* block = static_cast<Header*>(pointer) - 1;
+    if (!block->owner) return free(block);
+
+    Cache* cache = currentCache();
+    if (block->owner == cache) return cache->deallocate(block);
+    if (cache) cache->stats.remoteFrees++;
+    block->owner->deallocateRemote(block);
+  }
+
+  // Gets the statistics of the calling thread
+  static PooledAllocatorStats threadStats() {
+    Cache* cache = currentCache();
+    if (cache) return cache->stats;
+    PooledAllocatorStats empty = {0, 0, 0, 0, 0, 0, 0};
+    return empty;
+  }
+
+  // Releases the free blocks of the calling thread
+  static void trim() {
+    Cache* cache = currentCache();
+    if (cache) cache->trim();
+  }
+
+ private:
+  static Cache* currentCache() {
+    pthread_once(&_once, createKey);
+    return static_cast<Cache*>(pthread_getspecific(_key));
+  }
+
+  static Cache* threadCache() {
+    Cache* cache = currentCache();
+    if (cache) return cache;
+    cache = new Cache();
+    if (pthread_setspecific(_key, cache) == 0) return cache;
+    cache->close();
+    return NULL;
+  }
+
+  static void createKey() {
+    pthread_key_create(&_key, closeCache);
+  }
+
+  static void closeCache(void* cache) {
+    static_cast<Cache*>(cache)->close();
+  }
+
+  static pthread_key_t _key;
+  static pthread_once_t _once;
+};
+
+template <size_t BLOCK_SIZE, size_t MAX_CACHED_BYTES>
+pthread_key_t PooledAllocator<BLOCK_SIZE, MAX_CACHED_BYTES>::_key;
+
+template <size_t BLOCK_SIZE, size_t MAX_CACHED_BYTES>
+pthread_once_t PooledAllocator<BLOCK_SIZE, MAX_CACHED_BYTES>::_once =
+    PTHREAD_ONCE_INIT;
+
+// A DynamicJsonBuffer whose blocks come from PooledAllocator.
+// The default capacity is such that the first block fills the smallest size
+// class; since the capacity doubles, the following blocks fill the next
+// classes.
+template <typename TAllocator = PooledAllocator<> >
+class PooledJsonBufferBase
+    : public Internals::DynamicJsonBufferBase<TAllocator> {
+  typedef Internals::DynamicJsonBufferBase<TAllocator> base;
+
+ public:
+  static size_t defaultCapacity() {
+    return TAllocator::block_size - TAllocator::overhead -
+           base::EmptyBlockSize;
+  }
+
+  PooledJsonBufferBase() : base(defaultCapacity()) {}
+  explicit PooledJsonBufferBase(size_t initialSize) : base(initialSize) {}
+};
+
+typedef PooledJsonBufferBase<> PooledJsonBuffer;
+}  // namespace ArduinoJson
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#endif
@@ -0,0 +1,40 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+namespace ArduinoJson {
+
+// The retention policies tell what DynamicJsonBuffer::clear() does with the
+// memory blocks. They are passed as the second template argument of
+// DynamicJsonBufferBase, for example:
+//
+//   typedef Internals::DynamicJsonBufferBase<Internals::DefaultAllocator,
+//                                            KeepLargestBlock>
+//       RecyclingJsonBuffer;
+//
+// A policy that keeps memory remembers the high-water mark, which is the
+// largest number of bytes used between two calls to clear(). If the block it
+// keeps is smaller, the blocks are merged into one block of that size, so the
+// next documents of the same size are parsed without calling malloc().
+
+// Releases all the blocks, this is the default
+struct ReleaseAllBlocks {
+  static const size_t max_retained_bytes = 0;
+};
+
+// Keeps one block, as large as the high-water mark
+struct KeepLargestBlock {
+  static const size_t max_retained_bytes = size_t(-1);
+};
+
+// Keeps one block, as large as the high-water mark, up to MAX_BYTES.
+// Above this size, it keeps the largest block that fits.
+template <size_t MAX_BYTES>
+struct KeepBlocksUpTo {
+  static const size_t max_retained_bytes = MAX_BYTES;
+};
+}  // namespace ArduinoJson
@@ -65,36 +65,41 @@ inline void ArduinoJson::Internals::JsonSerializer<Writer>::serialize(
 template <typename Writer>
 inline void ArduinoJson::Internals::JsonSerializer<Writer>::serialize(
     const JsonVariant& variant, Writer& writer) {
-  switch (variant._type) {
+  switch (variant._data.type()) {
     case JSON_FLOAT:
-      writer.writeFloat(variant._content.asFloat);
+      writer.writeFloat(variant._data.asFloat());
       return;
 
     case JSON_ARRAY:
-      serialize(*variant._content.asArray, writer);
+      serialize(*variant._data.asArray(), writer);
       return;
 
     case JSON_OBJECT:
-      serialize(*variant._content.asObject, writer);
+      serialize(*variant._data.asObject(), writer);
       return;
 
     case JSON_STRING:
-      writer.writeString(variant._content.asString);
+      writer.writeString(variant._data.asString());
       return;
 
     case JSON_UNPARSED:
-      writer.writeRaw(variant._content.asString);
+    case JSON_UNPARSED_NULL:
+    case JSON_UNPARSED_BOOLEAN:
+    case JSON_UNPARSED_INTEGER:
+    case JSON_UNPARSED_FLOAT:
+    case JSON_UNPARSED_STRING:
+      writer.writeRaw(variant._data.asString());
       return;
 
     case JSON_NEGATIVE_INTEGER:
       writer.writeRaw('-');  // Falls through.
 
     case JSON_POSITIVE_INTEGER:
-      writer.writeInteger(variant._content.asInteger);
+      writer.writeInteger(variant._data.asInteger());
       return;
 
     case JSON_BOOLEAN:
-      writer.writeBoolean(variant._content.asInteger != 0);
+      writer.writeBoolean(variant._data.asInteger() != 0);
       return;
 
     default:  // JSON_UNDEFINED
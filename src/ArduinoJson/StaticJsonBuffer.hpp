@@ -24,6 +24,13 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
       }
     }
 
+    void append(const char* s, size_t n) {
+      // like append(char), copy as many chars as possible
+      size_t available = _parent->_capacity - _parent->_size;
+      if (n > available) n = available;
+      memcpy(_parent->doAlloc(n), s, n);
+    }
+
     const char* c_str() const {
       if (_parent->canAlloc(1)) {
         char* last = static_cast<char*>(_parent->doAlloc(1));
@@ -34,13 +41,22 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
       }
     }
 
+    // Releases the memory of the string.
+    // Nothing must have been allocated after it.
+    void discard() {
+      _parent->_size = static_cast<size_t>(_start - _parent->_buffer);
+      _parent->recordSize(_parent->_size);
+    }
+
    private:
     StaticJsonBufferBase* _parent;
     char* _start;
   };
 
   StaticJsonBufferBase(char* buffer, size_t capa)
-      : _buffer(buffer), _capacity(capa), _size(0) {}
+      : _buffer(buffer), _capacity(capa), _size(0) {
+    recordNewBlock();
+  }
 
   // Gets the capacity of the buffer in bytes
   size_t capacity() const {
@@ -54,7 +70,12 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
 
   // Allocates the specified amount of bytes in the buffer
   virtual void* alloc(size_t bytes) {
-    alignNextAlloc();
+    void* recycled = reuse(bytes);
+    if (recycled) {
+      recordAllocation(0);
+      return recycled;
+    }
+    recordAllocation(alignNextAlloc());
     if (!canAlloc(bytes)) return NULL;
     return doAlloc(bytes);
   }
@@ -63,6 +84,8 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
   // USE WITH CAUTION: this invalidates all previously allocated data
   void clear() {
     _size = 0;
+    recordClear();
+    resetFreeLists();
   }
 
   String startString() {
@@ -72,9 +95,18 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
  protected:
   ~StaticJsonBufferBase() {}
 
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  virtual bool owns(const void* p) const {
+    return p >= _buffer && p < _buffer + _size;
+  }
+#endif
+
  private:
-  void alignNextAlloc() {
+  // Returns the number of bytes skipped
+  size_t alignNextAlloc() {
+    size_t oldSize = _size;
     _size = round_size_up(_size);
+    return _size - oldSize;
   }
 
   bool canAlloc(size_t bytes) const {
@@ -84,6 +116,7 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
   void* doAlloc(size_t bytes) {
     void* p = &_buffer[_size];
     _size += bytes;
+    recordSize(_size);
     return p;
   }
 
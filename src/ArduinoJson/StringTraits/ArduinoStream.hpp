@@ -35,6 +35,8 @@ struct ArduinoStreamTraits {
       return _next;
     }
 
+    static const bool is_contiguous = false;
+
    private:
     char read() {
       // don't use _stream.read() as it ignores the timeout
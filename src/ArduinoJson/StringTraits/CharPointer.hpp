@@ -27,6 +27,17 @@ struct CharPointerTraits {
     char next() const {
       return char(_ptr[1]);
     }
+
+    // The whole input is in memory, so it can be scanned in bulk
+    static const bool is_contiguous = true;
+
+    const char* ptr() const {
+      return reinterpret_cast<const char*>(_ptr);
+    }
+
+    void seek(const char* p) {
+      _ptr = reinterpret_cast<const TChar*>(p);
+    }
   };
 
   static bool equals(const TChar* str, const char* expected) {
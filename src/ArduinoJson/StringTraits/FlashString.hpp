@@ -28,6 +28,8 @@ struct StringTraits<const __FlashStringHelper*, void> {
     char next() const {
       return pgm_read_byte_near(_ptr + 1);
     }
+
+    static const bool is_contiguous = false;
   };
 
   static bool equals(const __FlashStringHelper* str, const char* expected) {
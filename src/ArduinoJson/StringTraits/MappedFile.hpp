@@ -0,0 +1,28 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#if ARDUINOJSON_ENABLE_MMAP
+
+#include "../MappedFile.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+template <>
+struct StringTraits<MappedFile, void> {
+  // The file is in memory, so it's read like a char*
+  struct Reader : CharPointerTraits<char>::Reader {
+    Reader(const MappedFile& file)
+        : CharPointerTraits<char>::Reader(file.c_str()) {}
+  };
+
+  static const bool has_append = false;
+  static const bool has_equals = false;
+};
+}  // namespace Internals
+}  // namespace ArduinoJson
+
+#endif
@@ -12,34 +12,58 @@ namespace ArduinoJson {
 namespace Internals {
 
 struct StdStreamTraits {
+  // Reads directly from the stream buffer, instead of calling get() for each
+  // char, which builds a sentry every time.
+  // Only the chars that the parser moves past are consumed, so nothing is read
+  // past the end of the JSON document, and nothing is read before the parser
+  // needs it, which matters for pipes and sockets.
   class Reader {
     std::istream& _stream;
-    char _current, _next;
+    std::streambuf* _buffer;
+    char _held;  // the current char, consumed by next()
+    bool _isHeld;
 
    public:
-    Reader(std::istream& stream) : _stream(stream), _current(0), _next(0) {}
+    Reader(std::istream& stream)
+        : _stream(stream), _buffer(stream.rdbuf()), _held(0), _isHeld(false) {}
 
     void move() {
-      _current = _next;
-      _next = 0;
+      if (_isHeld) {
+        _isHeld = false;
+      } else if (_buffer) {
+        _buffer->sbumpc();
+      }
     }
 
     char current() {
-      if (!_current) _current = read();
-      return _current;
+      if (_isHeld) return _held;
+      return peek();
     }
 
     char next() {
       // assumes that current() has been called
-      if (!_next) _next = read();
-      return _next;
+      if (!_isHeld) {
+        _held = peek();
+        if (!_held) return '\0';
+        _buffer->sbumpc();
+        _isHeld = true;
+      }
+      return peek();
     }
 
+    static const bool is_contiguous = false;
+
    private:
     Reader& operator=(const Reader&);  // Visual Studio C4512
 
-    char read() {
-      return _stream.eof() ? '\0' : static_cast<char>(_stream.get());
+    char peek() {
+      typedef std::char_traits<char> traits;
+      traits::int_type c = _buffer ? _buffer->sgetc() : traits::eof();
+      if (traits::eq_int_type(c, traits::eof())) {
+        _stream.setstate(std::ios_base::eofbit);
+        return '\0';
+      }
+      return traits::to_char_type(c);
     }
   };
 
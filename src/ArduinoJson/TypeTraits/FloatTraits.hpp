@@ -25,6 +25,14 @@ struct FloatTraits<T, 8 /*64bits*/> {
   typedef int16_t exponent_type;
   static const exponent_type exponent_max = 308;
 
+  // for computeFloat()
+  static const short exponent_min = -342;
+  static const short exponent_bias = 1023;
+  static const short round_to_even_min = -4;
+  static const short round_to_even_max = 23;
+  static const short exact_power_max = 22;
+  static const uint64_t exact_mantissa_max = uint64_t(1) << 53;
+
   template <typename TExponent>
   static T make_float(T m, TExponent e) {
     if (e > 0) {
@@ -72,6 +80,14 @@ struct FloatTraits<T, 8 /*64bits*/> {
     return factors[index];
   }
 
+  // The powers of ten that are exactly representable
+  static T exactPowerOfTen(int index) {
+    static T factors[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    return factors[index];
+  }
+
   static T negativeBinaryPowerOfTenPlusOne(int index) {
     static T factors[] = {
         1e0,
@@ -106,6 +122,19 @@ struct FloatTraits<T, 8 /*64bits*/> {
     integerBits = (uint64_t(msb) << 32) | lsb;
     return floatBits;
   }
+
+  static T make_float_from_bits(uint64_t bits) {
+    return forge(uint32_t(bits >> 32), uint32_t(bits));
+  }
+
+  static uint64_t make_bits_from_float(T value) {
+    union {
+      uint64_t integerBits;
+      T floatBits;
+    };
+    floatBits = value;
+    return integerBits;
+  }
 };
 
 template <typename T>
@@ -118,6 +147,14 @@ struct FloatTraits<T, 4 /*32bits*/> {
   typedef int8_t exponent_type;
   static const exponent_type exponent_max = 38;
 
+  // for computeFloat()
+  static const short exponent_min = -65;
+  static const short exponent_bias = 127;
+  static const short round_to_even_min = -17;
+  static const short round_to_even_max = 10;
+  static const short exact_power_max = 10;
+  static const uint64_t exact_mantissa_max = uint64_t(1) << 24;
+
   template <typename TExponent>
   static T make_float(T m, TExponent e) {
     if (e > 0) {
@@ -145,6 +182,13 @@ struct FloatTraits<T, 4 /*32bits*/> {
     return factors[index];
   }
 
+  // The powers of ten that are exactly representable
+  static T exactPowerOfTen(int index) {
+    static T factors[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                          1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    return factors[index];
+  }
+
   static T negativeBinaryPowerOfTenPlusOne(int index) {
     static T factors[] = {1e0f, 1e-1f, 1e-3f, 1e-7f, 1e-15f, 1e-31f};
     return factors[index];
@@ -159,6 +203,19 @@ struct FloatTraits<T, 4 /*32bits*/> {
     return floatBits;
   }
 
+  static T make_float_from_bits(uint64_t bits) {
+    return forge(uint32_t(bits));
+  }
+
+  static uint64_t make_bits_from_float(T value) {
+    union {
+      uint32_t integerBits;
+      T floatBits;
+    };
+    floatBits = value;
+    return integerBits;
+  }
+
   static T nan() {
     return forge(0x7fc00000);
   }
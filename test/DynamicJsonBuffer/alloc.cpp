@@ -57,6 +57,18 @@ TEST_CASE("DynamicJsonBuffer::alloc()") {
     REQUIRE(allocatorLog.str() == "A1A2FFA1F");
   }
 
+  SECTION("Stops doubling at the maximum capacity") {
+    allocatorLog.str("");
+    {
+      DynamicJsonBufferBase<SpyingAllocator> buffer(1, 3);
+      buffer.alloc(1);
+      buffer.alloc(2);
+      buffer.alloc(3);
+      buffer.alloc(3);
+    }
+    REQUIRE(allocatorLog.str() == "A1A2A3A3FFFF");
+  }
+
   SECTION("Makes a big allocation when needed") {
     allocatorLog.str("");
     {
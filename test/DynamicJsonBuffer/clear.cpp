@@ -0,0 +1,117 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace ArduinoJson::Internals;
+
+static std::stringstream blockLog;
+
+struct LoggingAllocator : DefaultAllocator {
+  void* allocate(size_t n) {
+    blockLog << "A" << (n - DynamicJsonBuffer::EmptyBlockSize);
+    return DefaultAllocator::allocate(n);
+  }
+  void deallocate(void* p) {
+    blockLog << "F";
+    return DefaultAllocator::deallocate(p);
+  }
+};
+
+template <typename TJsonBuffer>
+static void parseSomething(TJsonBuffer& buffer) {
+  char json[] = "[\"one\",\"two\",\"three\",{\"four\":4}]";
+  JsonArray& arr = buffer.parseArray(json);
+  REQUIRE(arr.success());
+  REQUIRE(arr[2] == std::string("three"));
+  REQUIRE(arr[3]["four"] == 4);
+}
+
+TEST_CASE("DynamicJsonBuffer::clear()") {
+  SECTION("ReleaseAllBlocks") {
+    blockLog.str("");
+    {
+      DynamicJsonBufferBase<LoggingAllocator> buffer(1);
+      buffer.alloc(1);
+      buffer.alloc(1);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A1A2FF");
+    }
+    REQUIRE(blockLog.str() == "A1A2FF");
+  }
+
+  SECTION("KeepLargestBlock keeps a block that is large enough") {
+    blockLog.str("");
+    {
+      DynamicJsonBufferBase<LoggingAllocator, KeepLargestBlock> buffer(16);
+      buffer.alloc(4);
+      buffer.alloc(4);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A16");
+      REQUIRE(0 == buffer.size());
+
+      buffer.alloc(16);
+      REQUIRE(blockLog.str() == "A16");
+    }
+    REQUIRE(blockLog.str() == "A16F");
+  }
+
+  SECTION("KeepLargestBlock merges the blocks at the high-water mark") {
+    blockLog.str("");
+    {
+      DynamicJsonBufferBase<LoggingAllocator, KeepLargestBlock> buffer(8);
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A8A16FFA24");
+
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A8A16FFA24");
+    }
+  }
+
+  SECTION("KeepLargestBlock makes steady-state parsing malloc-free") {
+    DynamicJsonBufferBase<LoggingAllocator, KeepLargestBlock> buffer(8);
+    parseSomething(buffer);
+    buffer.clear();
+
+    blockLog.str("");
+    for (int i = 0; i < 3; i++) {
+      parseSomething(buffer);
+      buffer.clear();
+    }
+    REQUIRE(blockLog.str() == "");
+  }
+
+  SECTION("KeepBlocksUpTo keeps the largest block below the limit") {
+    blockLog.str("");
+    {
+      DynamicJsonBufferBase<LoggingAllocator, KeepBlocksUpTo<16> > buffer(8);
+      buffer.alloc(8);
+      buffer.alloc(16);
+      buffer.alloc(32);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A8A16A32FF");
+    }
+    REQUIRE(blockLog.str() == "A8A16A32FFF");
+  }
+
+  SECTION("KeepBlocksUpTo merges up to the limit") {
+    blockLog.str("");
+    {
+      DynamicJsonBufferBase<LoggingAllocator, KeepBlocksUpTo<20> > buffer(8);
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.alloc(8);
+      buffer.clear();
+      REQUIRE(blockLog.str() == "A8A16FFA20");
+    }
+  }
+}
@@ -0,0 +1,89 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#if ARDUINOJSON_ENABLE_MMAP
+
+using namespace ArduinoJson;
+
+typedef HugePageAllocator<4096, 4 * 1024 * 1024> SmallHugePageAllocator;
+typedef HugePageJsonBufferBase<SmallHugePageAllocator> SmallHugePageJsonBuffer;
+
+static const size_t hugePageSize = SmallHugePageAllocator::huge_page_size;
+
+static bool isHugePageAligned(void* p) {
+  char* block = static_cast<char*>(p) - SmallHugePageAllocator::overhead;
+  return reinterpret_cast<size_t>(block) % hugePageSize == 0;
+}
+
+TEST_CASE("HugePageAllocator") {
+  SmallHugePageAllocator allocator;
+
+  SECTION("sends small allocations to malloc()") {
+    void* p = allocator.allocate(100);
+    REQUIRE(p != NULL);
+    REQUIRE(0 == allocator.mappedBytes());
+    allocator.deallocate(p);
+    REQUIRE(0 == allocator.pooledBytes());
+  }
+
+  SECTION("maps large allocations on huge pages") {
+    void* p = allocator.allocate(5000);
+    REQUIRE(isHugePageAligned(p));
+    REQUIRE(hugePageSize == allocator.mappedBytes());
+    allocator.deallocate(p);
+  }
+
+  SECTION("rounds the mappings to whole huge pages") {
+    void* p = allocator.allocate(hugePageSize);
+    REQUIRE(2 * hugePageSize == allocator.mappedBytes());
+    allocator.deallocate(p);
+  }
+
+  SECTION("reuses the mappings of the pool") {
+    void* a = allocator.allocate(hugePageSize);
+    allocator.deallocate(a);
+    REQUIRE(2 * hugePageSize == allocator.pooledBytes());
+
+    void* b = allocator.allocate(5000);
+    REQUIRE(a == b);
+    REQUIRE(0 == allocator.pooledBytes());
+    REQUIRE(2 * hugePageSize == allocator.mappedBytes());
+    allocator.deallocate(b);
+  }
+
+  SECTION("caps the bytes in the pool") {
+    void* a = allocator.allocate(hugePageSize);
+    void* b = allocator.allocate(hugePageSize);
+    void* c = allocator.allocate(5000);
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(c);
+
+    REQUIRE(2 * hugePageSize == allocator.pooledBytes());
+    REQUIRE(2 * hugePageSize == allocator.mappedBytes());
+  }
+
+  SECTION("pre-faults the pages") {
+    HugePageAllocator<4096, 0, true> prefaulting;
+    char* p = static_cast<char*>(prefaulting.allocate(5000));
+    REQUIRE(p != NULL);
+    REQUIRE(p[4999] == 0);
+    prefaulting.deallocate(p);
+    REQUIRE(0 == prefaulting.mappedBytes());
+  }
+}
+
+TEST_CASE("HugePageJsonBuffer") {
+  SECTION("blocks fill the huge pages") {
+    SmallHugePageJsonBuffer jb;
+    jb.alloc(1);
+    jb.alloc(SmallHugePageJsonBuffer::blockCapacity(1));
+    REQUIRE(3 * hugePageSize == jb.allocator().mappedBytes());
+  }
+}
+
+#endif
@@ -0,0 +1,143 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#if ARDUINOJSON_ENABLE_THREAD_POOL
+
+using namespace ArduinoJson;
+
+typedef PooledAllocator<256, 1024> SmallPool;
+typedef PooledJsonBufferBase<SmallPool> SmallPooledJsonBuffer;
+
+static void* allocateInThread(void* size) {
+  return SmallPool().allocate(*static_cast<size_t*>(size));
+}
+
+static void* deallocateInThread(void* pointer) {
+  SmallPool().deallocate(pointer);
+  return NULL;
+}
+
+static void* runInThread(void* (*function)(void*), void* arg) {
+  pthread_t thread;
+  REQUIRE(0 == pthread_create(&thread, NULL, function, arg));
+  void* result;
+  pthread_join(thread, &result);
+  return result;
+}
+
+TEST_CASE("PooledAllocator") {
+  SmallPool pool;
+  SmallPool::trim();
+  PooledAllocatorStats before = SmallPool::threadStats();
+
+  SECTION("reuses the freed blocks") {
+    void* a = pool.allocate(100);
+    pool.deallocate(a);
+    void* b = pool.allocate(200);
+
+    REQUIRE(a == b);
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(1 == after.blocksCreated - before.blocksCreated);
+    REQUIRE(1 == after.blocksReused - before.blocksReused);
+    pool.deallocate(b);
+  }
+
+  SECTION("has one free list per size class") {
+    void* a = pool.allocate(100);
+    pool.deallocate(a);
+    void* b = pool.allocate(300);
+
+    REQUIRE(a != b);
+    REQUIRE(1 == SmallPool::threadStats().cachedBlocks);
+    pool.deallocate(b);
+    REQUIRE(256 + 512 == SmallPool::threadStats().cachedBytes);
+  }
+
+  SECTION("sends oversized allocations to malloc()") {
+    void* a = pool.allocate(256 * 128);
+    REQUIRE(a != NULL);
+    pool.deallocate(a);
+
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(1 == after.oversized - before.oversized);
+    REQUIRE(0 == after.cachedBlocks);
+  }
+
+  SECTION("caps the bytes in the free lists") {
+    void* a = pool.allocate(600);
+    void* b = pool.allocate(600);
+    pool.deallocate(a);
+    pool.deallocate(b);
+
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(1 == after.cachedBlocks);
+    REQUIRE(1024 == after.cachedBytes);
+    REQUIRE(1 == after.blocksReleased - before.blocksReleased);
+  }
+
+  SECTION("trim() releases the free blocks") {
+    pool.deallocate(pool.allocate(100));
+    SmallPool::trim();
+
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(0 == after.cachedBlocks);
+    REQUIRE(1 == after.blocksReleased - before.blocksReleased);
+  }
+
+  SECTION("gets back the blocks freed in another thread") {
+    void* a = pool.allocate(100);
+    runInThread(deallocateInThread, a);
+    void* b = pool.allocate(100);
+
+    REQUIRE(a == b);
+    REQUIRE(1 == SmallPool::threadStats().blocksReused - before.blocksReused);
+    pool.deallocate(b);
+  }
+
+  SECTION("releases the blocks of a thread that exited") {
+    size_t size = 100;
+    void* a = runInThread(allocateInThread, &size);
+    REQUIRE(a != NULL);
+
+    pool.deallocate(a);
+    REQUIRE(1 == SmallPool::threadStats().remoteFrees - before.remoteFrees);
+    REQUIRE(0 == SmallPool::threadStats().cachedBlocks);
+  }
+}
+
+TEST_CASE("PooledJsonBuffer") {
+  SmallPool::trim();
+  PooledAllocatorStats before = SmallPool::threadStats();
+
+  SECTION("blocks fill the size classes") {
+    {
+      SmallPooledJsonBuffer jb;
+      jb.alloc(SmallPooledJsonBuffer::defaultCapacity());
+      jb.alloc(2 * SmallPooledJsonBuffer::defaultCapacity());
+    }
+
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(2 == after.blocksCreated - before.blocksCreated);
+    REQUIRE(256 + 512 == after.cachedBytes);
+    REQUIRE(0 == after.oversized - before.oversized);
+  }
+
+  SECTION("steady-state parsing reuses the blocks") {
+    for (int i = 0; i < 3; i++) {
+      SmallPooledJsonBuffer jb;
+      char json[] = "{\"hello\":[\"world\",42]}";
+      JsonObject& obj = jb.parseObject(json);
+      REQUIRE(obj["hello"][1] == 42);
+    }
+
+    PooledAllocatorStats after = SmallPool::threadStats();
+    REQUIRE(1 == after.blocksCreated - before.blocksCreated);
+    REQUIRE(2 == after.blocksReused - before.blocksReused);
+  }
+}
+
+#endif
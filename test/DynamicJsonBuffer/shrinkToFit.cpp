@@ -0,0 +1,70 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace ArduinoJson::Internals;
+
+static std::stringstream shrinkLog;
+
+struct ShrinkLoggingAllocator : DefaultAllocator {
+  void* allocate(size_t n) {
+    shrinkLog << "A" << (n - DynamicJsonBuffer::EmptyBlockSize);
+    return DefaultAllocator::allocate(n);
+  }
+  void deallocate(void* p) {
+    shrinkLog << "F";
+    return DefaultAllocator::deallocate(p);
+  }
+};
+
+TEST_CASE("DynamicJsonBuffer::shrinkToFit()") {
+  DynamicJsonBufferBase<ShrinkLoggingAllocator> jb(16);
+
+  SECTION("Moves the document in one block of the exact size") {
+    JsonObject& root = jb.createObject();
+    root["hello"] = std::string("world");
+    JsonArray& array = root.createNestedArray("numbers");
+    for (int i = 0; i < 10; i++) array.add(i);
+    array.remove(0);
+    root.remove("hello");
+
+    size_t compactSize = JsonVariant(root).compactSize();
+    REQUIRE(compactSize < jb.size());
+
+    shrinkLog.str("");
+    JsonObject& copy = jb.shrinkToFit(root).as<JsonObject>();
+
+    std::stringstream expected;
+    expected << "A" << compactSize << "FFFFF";
+    REQUIRE(expected.str() == shrinkLog.str());
+    REQUIRE(compactSize == jb.size());
+
+    std::string json;
+    copy.printTo(json);
+    REQUIRE("{\"numbers\":[1,2,3,4,5,6,7,8,9]}" == json);
+  }
+
+  SECTION("Releases everything for a scalar") {
+    jb.alloc(8);
+
+    shrinkLog.str("");
+    JsonVariant copy = jb.shrinkToFit(JsonVariant(42));
+
+    REQUIRE("F" == shrinkLog.str());
+    REQUIRE(42 == copy.as<int>());
+    REQUIRE(0 == jb.size());
+  }
+
+  SECTION("Can still allocate after") {
+    JsonArray& root = jb.createArray();
+    root.add(1);
+    JsonArray& copy = jb.shrinkToFit(root).as<JsonArray>();
+
+    REQUIRE(copy.add(2));
+    REQUIRE(2 == copy.size());
+  }
+}
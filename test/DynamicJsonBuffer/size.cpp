@@ -19,6 +19,14 @@ TEST_CASE("DynamicJsonBuffer::size()") {
     REQUIRE(2U <= buffer.size());
   }
 
+  SECTION("Sums the sizes of all the blocks") {
+    DynamicJsonBuffer smallBuffer(8);
+    smallBuffer.alloc(8);
+    smallBuffer.alloc(16);
+    smallBuffer.alloc(32);
+    REQUIRE(56 == smallBuffer.size());
+  }
+
   SECTION("Goes back to 0 after clear()") {
     buffer.alloc(1);
     buffer.clear();
@@ -5,6 +5,17 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+using namespace ArduinoJson::Internals;
+
+static int allocationCount;
+
+struct CountingAllocator : DefaultAllocator {
+  void* allocate(size_t n) {
+    allocationCount++;
+    return DefaultAllocator::allocate(n);
+  }
+};
+
 TEST_CASE("DynamicJsonBuffer::startString()") {
   SECTION("WorksWhenBufferIsBigEnough") {
     DynamicJsonBuffer jsonBuffer(6);
@@ -44,4 +55,52 @@ TEST_CASE("DynamicJsonBuffer::startString()") {
     str.c_str();
     REQUIRE(2 == jsonBuffer.size());
   }
+
+  SECTION("AppendsSeveralCharsAtOnce") {
+    DynamicJsonBuffer jsonBuffer(6);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    str.append("lo", 2);
+
+    REQUIRE(std::string("hello") == str.c_str());
+    REQUIRE(6 == jsonBuffer.size());
+  }
+
+  SECTION("GrowsWhenAppendingSeveralChars") {
+    DynamicJsonBuffer jsonBuffer(4);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    str.append("lo world", 8);
+
+    REQUIRE(std::string("hello world") == str.c_str());
+  }
+
+  SECTION("MovesLongStringsLogarithmically") {
+    DynamicJsonBufferBase<CountingAllocator> jsonBuffer(4);
+    allocationCount = 0;
+
+    DynamicJsonBufferBase<CountingAllocator>::String str =
+        jsonBuffer.startString();
+    for (int i = 0; i < 10000; i++) str.append('x');
+
+    REQUIRE(10000 == strlen(str.c_str()));
+    REQUIRE(allocationCount <= 14);
+  }
+
+  SECTION("CountsTheBytesLeftBehind") {
+    DynamicJsonBuffer jsonBuffer(4);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    REQUIRE(0 == jsonBuffer.wastedStringBytes());
+
+    str.append("lo world", 8);
+    REQUIRE(3 == jsonBuffer.wastedStringBytes());
+    REQUIRE(std::string("hello world") == str.c_str());
+
+    jsonBuffer.clear();
+    REQUIRE(0 == jsonBuffer.wastedStringBytes());
+  }
 }
@@ -0,0 +1,92 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <vector>
+
+static const int largeSize = 10 * ARDUINOJSON_ARRAY_INDEX_THRESHOLD + 7;
+
+TEST_CASE("JsonArray index") {
+  DynamicJsonBuffer jb;
+  JsonArray& array = jb.createArray();
+  for (int i = 0; i < largeSize; i++) array.add(i);
+
+  SECTION("get() returns every element") {
+    REQUIRE(largeSize == array.size());
+    for (int i = 0; i < largeSize; i++) REQUIRE(i == array.get<int>(i));
+    REQUIRE(0 == array.get<int>(largeSize));
+  }
+
+  SECTION("set() replaces every element") {
+    for (int i = 0; i < largeSize; i++) array.set(i, -i);
+    for (int i = 0; i < largeSize; i++) REQUIRE(-i == array[i].as<int>());
+    REQUIRE_FALSE(array.set(largeSize, 0));
+  }
+
+  SECTION("remove() then add()") {
+    array.remove(1);
+    array.remove(largeSize - 2);
+    for (int i = 0; i < 20; i++) array.add(largeSize + i);
+
+    REQUIRE(largeSize + 18 == array.size());
+    REQUIRE(0 == array[0]);
+    for (int i = 1; i < largeSize - 2; i++) REQUIRE(i + 1 == array[i]);
+    for (int i = 0; i < 20; i++)
+      REQUIRE(largeSize + i == array[largeSize - 2 + i]);
+  }
+
+  SECTION("remove() keeps the index") {
+    const size_t stride = ARDUINOJSON_ARRAY_INDEX_STRIDE;
+    std::vector<int> expected;
+    for (int i = 0; i < largeSize; i++) expected.push_back(i);
+    size_t positions[] = {largeSize - 1, 5 * stride, stride - 1, 0};
+    for (size_t i = 0; i < 4; i++) {
+      array.remove(positions[i]);
+      expected.erase(expected.begin() + static_cast<int>(positions[i]));
+    }
+
+    REQUIRE(expected.size() == array.size());
+    for (size_t i = 0; i < expected.size(); i++)
+      REQUIRE(expected[i] == array[i]);
+  }
+
+  SECTION("remove() until the last indexed node") {
+    while (array.size() > 1) array.remove(array.size() - 2);
+
+    REQUIRE(largeSize - 1 == array[0]);
+    array.add(42);
+    REQUIRE(42 == array[1]);
+  }
+
+  SECTION("compactInto() copies the index") {
+    JsonVariant root = array;
+    DynamicJsonBuffer destination;
+    JsonArray& copy = root.compactInto(destination).as<JsonArray>();
+
+    REQUIRE(root.compactSize() == destination.size());
+    for (int i = 0; i < largeSize; i++) REQUIRE(i == copy[i]);
+  }
+}
+
+TEST_CASE("JsonArray index after remove()") {
+  // would take seconds if get() walked the list
+  const int size = 100000;
+  DynamicJsonBuffer jb;
+  JsonArray& array = jb.createArray();
+  for (int i = 0; i <= size; i++) array.add(i);
+  array.remove(0);
+
+  int mismatches = 0;
+  for (int i = 0; i < size; i++) mismatches += array.get<int>(i) - i != 1;
+  REQUIRE(0 == mismatches);
+}
+
+TEST_CASE("JSON_ARRAY_SIZE() includes the index") {
+  StaticJsonBuffer<JSON_ARRAY_SIZE(largeSize)> jb;
+  JsonArray& array = jb.createArray();
+  for (int i = 0; i < largeSize; i++) REQUIRE(array.add(i));
+
+  REQUIRE(largeSize - 1 == array[largeSize - 1]);
+}
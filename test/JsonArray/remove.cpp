@@ -20,6 +20,14 @@ TEST_CASE("JsonArray::remove()") {
     REQUIRE(_array[1] == 3);
   }
 
+  SECTION("RemoveLastThenAdd") {
+    _array.remove(2);
+    _array.add(4);
+
+    REQUIRE(3 == _array.size());
+    REQUIRE(_array[2] == 4);
+  }
+
   SECTION("RemoveMiddleByIndex") {
     _array.remove(1);
 
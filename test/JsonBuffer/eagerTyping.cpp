@@ -0,0 +1,118 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <limits>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+struct EagerStructuralIndexParsing : DefaultParsing {
+  static const bool use_structural_index = true;
+  static const bool eager_typing = true;
+};
+
+template <typename TPolicy>
+static void testEagerTyping() {
+  DynamicJsonBuffer jb;
+
+  SECTION("Integers") {
+    JsonArray& arr = jb.parseArray<TPolicy>("[0,42,-42,+7]");
+
+    REQUIRE(arr[0].template is<int>());
+    REQUIRE(arr[1].template as<int>() == 42);
+    REQUIRE(arr[2].template as<long>() == -42);
+    REQUIRE(arr[3].template as<int>() == 7);
+    REQUIRE(arr[1].template is<float>());
+    REQUIRE_FALSE(arr[1].template is<const char*>());
+  }
+
+  SECTION("Floats") {
+    JsonArray& arr = jb.parseArray<TPolicy>("[3.14,-1e2,NaN]");
+
+    REQUIRE(arr[0].template is<double>());
+    REQUIRE_FALSE(arr[0].template is<int>());
+    REQUIRE(arr[0].template as<double>() == 3.14);
+    REQUIRE(arr[1].template as<double>() == -100);
+    REQUIRE(arr[2].template as<double>() != arr[2].template as<double>());
+  }
+
+  SECTION("Booleans") {
+    JsonArray& arr = jb.parseArray<TPolicy>("[true,false]");
+
+    REQUIRE(arr[0].template is<bool>());
+    REQUIRE(arr[0].template as<bool>() == true);
+    REQUIRE(arr[1].template as<bool>() == false);
+  }
+
+  SECTION("Other values remain unparsed") {
+    JsonArray& arr = jb.parseArray<TPolicy>("[null,hello,\"42\",]");
+
+    REQUIRE(arr[0].template as<const char*>() == 0);
+    REQUIRE(arr[1] == std::string("hello"));
+    REQUIRE(arr[2].template is<const char*>());
+    REQUIRE(arr[3] == std::string(""));
+  }
+
+  SECTION("Integers that don't fit remain unparsed") {
+    JsonArray& arr = jb.parseArray<TPolicy>(
+        "[99999999999999999999999,-99999999999999999999999]");
+
+    REQUIRE(arr[0].template as<const char*>() ==
+            std::string("99999999999999999999999"));
+    REQUIRE(arr[1].template as<const char*>() ==
+            std::string("-99999999999999999999999"));
+  }
+
+  SECTION("Largest integers") {
+    JsonArray& arr = jb.parseArray<TPolicy>(
+        "[18446744073709551615,-9223372036854775807]");
+
+    if (sizeof(JsonUInt) == 8) {
+      REQUIRE(arr[0].template as<JsonUInt>() ==
+              std::numeric_limits<JsonUInt>::max());
+      REQUIRE(arr[1].template as<JsonInteger>() ==
+              -std::numeric_limits<JsonInteger>::max());
+    }
+  }
+
+  SECTION("Object members") {
+    JsonObject& obj =
+        jb.parseObject<TPolicy>("{\"a\":1,\"b\":-2.5,\"c\":true}");
+
+    REQUIRE(obj["a"] == 1);
+    REQUIRE(obj["b"] == -2.5);
+    REQUIRE(obj["c"] == true);
+    std::string json;
+    obj.printTo(json);
+    REQUIRE(json == "{\"a\":1,\"b\":-2.5,\"c\":true}");
+  }
+
+  SECTION("The text is not stored") {
+    DynamicJsonBuffer jb2;
+
+    jb.parseArray<TPolicy>("[123456789,1.5,true]");
+    jb2.parseArray("[123456789,1.5,true]");
+
+    REQUIRE(jb.size() < jb2.size());
+  }
+
+  SECTION("Writable input") {
+    char input[] = "[42,\"x\",true]";
+    JsonArray& arr = jb.parseArray<TPolicy>(input);
+
+    REQUIRE(arr[0] == 42);
+    REQUIRE(arr[1] == std::string("x"));
+    REQUIRE(arr[2] == true);
+  }
+}
+
+TEST_CASE("EagerTypingParsing") {
+  testEagerTyping<EagerTypingParsing>();
+}
+
+TEST_CASE("EagerTypingParsing with structural index") {
+  testEagerTyping<EagerStructuralIndexParsing>();
+}
@@ -0,0 +1,138 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static std::string toJson(const JsonVariant& variant) {
+  std::string output;
+  variant.printTo(output);
+  return output;
+}
+
+TEST_CASE("JsonBuffer::parse() with JsonFilter") {
+  DynamicJsonBuffer filterBuffer;
+  DynamicJsonBuffer jb;
+
+  const char json[] =
+      "{\"count\":2,\"data\":[{\"id\":1,\"name\":\"foo\",\"price\":2.5,"
+      "\"tags\":[\"a\",{\"b\":[]}]},{\"id\":2,\"price\":3,\"extra\":null}],"
+      "\"next\":{\"page\":2}}";
+
+  SECTION("Keeps only the whitelisted fields") {
+    JsonObject& filter =
+        filterBuffer.parseObject("{\"data\":[{\"id\":true,\"price\":true}]}");
+
+    JsonObject& obj = jb.parseObject(json, filter);
+
+    REQUIRE(obj.success());
+    REQUIRE(toJson(obj) ==
+            "{\"data\":[{\"id\":1,\"price\":2.5},{\"id\":2,\"price\":3}]}");
+  }
+
+  SECTION("true keeps the whole subtree") {
+    JsonObject& filter = filterBuffer.parseObject("{\"next\":true}");
+
+    JsonObject& obj = jb.parseObject(json, filter);
+
+    REQUIRE(toJson(obj) == "{\"next\":{\"page\":2}}");
+  }
+
+  SECTION("Values with a different type are skipped") {
+    JsonObject& filter =
+        filterBuffer.parseObject("{\"count\":{},\"data\":{},\"next\":[]}");
+
+    JsonObject& obj = jb.parseObject(json, filter);
+
+    REQUIRE(obj.success());
+    REQUIRE(obj.size() == 0);
+  }
+
+  SECTION("Root array") {
+    JsonArray& filter = filterBuffer.parseArray("[{\"id\":true}]");
+
+    JsonArray& arr = jb.parseArray("[{\"id\":1,\"x\":2},{\"y\":3},4]", filter);
+
+    REQUIRE(arr.success());
+    REQUIRE(toJson(arr) == "[{\"id\":1},{}]");
+  }
+
+  SECTION("parse()") {
+    JsonObject& filter = filterBuffer.parseObject("{\"count\":true}");
+
+    JsonVariant variant = jb.parse(json, filter);
+
+    REQUIRE(toJson(variant) == "{\"count\":2}");
+  }
+
+  SECTION("A filter true keeps everything") {
+    DynamicJsonBuffer jb2;
+
+    jb.parse(json, JsonFilter(true));
+    jb2.parse(json);
+
+    REQUIRE(jb.size() == jb2.size());
+  }
+
+  SECTION("Skipped fields don't use the buffer") {
+    JsonObject& filter = filterBuffer.parseObject("{\"b\":true}");
+    DynamicJsonBuffer jb2;
+
+    jb.parseObject("{\"a\":\"skipped\",\"b\":1,\"long key\":[1,2,3]}", filter);
+    jb2.parseObject("{\"b\":1}");
+
+    REQUIRE(jb.size() == jb2.size());
+  }
+
+  SECTION("Skipped fields of a writable input") {
+    JsonObject& filter = filterBuffer.parseObject("{\"b\":true}");
+    char input[] = "{\"a\":\"\\\"skipped\\\"\",\"b\":\"hello\\tworld\"}";
+
+    JsonObject& obj = jb.parseObject(input, filter);
+
+    REQUIRE(obj.size() == 1);
+    REQUIRE(obj["b"] == "hello\tworld");
+  }
+
+  SECTION("std::istream") {
+    JsonObject& filter = filterBuffer.parseObject("{\"next\":true}");
+    std::istringstream input(json);
+
+    JsonObject& obj = jb.parseObject(input, filter);
+
+    REQUIRE(toJson(obj) == "{\"next\":{\"page\":2}}");
+  }
+
+  SECTION("Fits in a StaticJsonBuffer too small for the whole document") {
+    JsonObject& filter =
+        filterBuffer.parseObject("{\"data\":[{\"id\":true}]}");
+    StaticJsonBuffer<JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(2) +
+                     2 * JSON_OBJECT_SIZE(1) + 40>
+        sjb;
+
+    REQUIRE_FALSE(sjb.parseObject(json).success());
+    sjb.clear();
+    JsonObject& obj = sjb.parseObject(json, filter);
+
+    REQUIRE(toJson(obj) == "{\"data\":[{\"id\":1},{\"id\":2}]}");
+  }
+
+  SECTION("Skipped values follow the grammar") {
+    JsonObject& filter = filterBuffer.parseObject("{}");
+
+    REQUIRE(jb.parseObject("{\"a\":[1,/*x*/{'b':c}]}", filter).success());
+    REQUIRE_FALSE(jb.parseObject("{\"a\":[1 2]}", filter).success());
+    REQUIRE_FALSE(jb.parseObject("{\"a\":{\"b\"}}", filter).success());
+    REQUIRE_FALSE(jb.parseObject("{\"a\":[}", filter).success());
+  }
+
+  SECTION("Skipped values respect the nesting limit") {
+    JsonObject& filter = filterBuffer.parseObject("{}");
+
+    REQUIRE(jb.parseObject("{\"a\":[[]]}", filter, 3).success());
+    REQUIRE_FALSE(jb.parseObject("{\"a\":[[]]}", filter, 2).success());
+  }
+}
@@ -0,0 +1,116 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS") {
+  SECTION("JsonArray::remove() recycles the node") {
+    DynamicJsonBuffer jb;
+    JsonArray& array = jb.createArray();
+    array.add(1);
+    array.add(2);
+    size_t size = jb.size();
+
+    for (int i = 0; i < 100; i++) {
+      array.remove(0);
+      array.add(i);
+    }
+
+    REQUIRE(size == jb.size());
+    REQUIRE(2 == array.size());
+    REQUIRE(99 == array[1]);
+  }
+
+  SECTION("JsonObject::remove() recycles the node") {
+    DynamicJsonBuffer jb;
+    JsonObject& object = jb.createObject();
+    object["temperature"] = "decreasing";
+    size_t size = jb.size();
+
+    for (int i = 0; i < 100; i++) {
+      object.remove("temperature");
+      object["temperature"] = i % 2 ? "increasing" : "decreasing";
+    }
+
+    REQUIRE(size == jb.size());
+    REQUIRE(std::string("increasing") ==
+            object["temperature"].as<const char*>());
+  }
+
+  SECTION("Doesn't recycle the strings shared by JsonObject") {
+    DynamicJsonBuffer jb;
+    JsonObject& object = jb.createObject();
+    object["a"] = std::string("hello world, a long value");
+    object["b"] = object["a"];
+    object.remove("a");
+    object["c"] = std::string("XXXXXXXXXXXXXXXXXXXXXXXX!");
+
+    REQUIRE(std::string("hello world, a long value") ==
+            object["b"].as<const char*>());
+  }
+
+  SECTION("Doesn't recycle the strings shared by JsonArray") {
+    DynamicJsonBuffer jb;
+    JsonArray& array = jb.createArray();
+    array.add(std::string("hello world, a long value"));
+    array.add(array[0]);
+    array.remove(0);
+    array.add(std::string("XXXXXXXXXXXXXXXXXXXXXXXX!"));
+
+    REQUIRE(std::string("hello world, a long value") ==
+            array[0].as<const char*>());
+  }
+
+  SECTION("Doesn't align the strings") {
+    DynamicJsonBuffer jb;
+    JsonObject& object = jb.parseObject(std::string("{\"a\":\"b\"}"));
+    const char* key = object.begin()->key;
+    const char* value = object.begin()->value;
+
+    REQUIRE(key + 2 == value);
+  }
+
+  SECTION("Works with StaticJsonBuffer") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(2)> jb;
+    JsonArray& array = jb.createArray();
+    array.add(1);
+    array.add(2);
+
+    array.remove(0);
+    REQUIRE(array.add(3));
+    std::string json;
+    array.printTo(json);
+    REQUIRE("[2,3]" == json);
+  }
+
+  SECTION("Ignores the strings outside of the buffer") {
+    char input[] = "{\"key\":\"value\"}";
+    DynamicJsonBuffer jb;
+    JsonObject& object = jb.parseObject(input);
+    const char* key = object.begin()->key;
+    const char* value = object.begin()->value;
+    object.remove("key");
+
+    // the strings are in the input, they must not be reused
+    object[std::string("other")] = std::string("0123456789");
+
+    REQUIRE(std::string("key") == key);
+    REQUIRE(std::string("value") == value);
+  }
+
+  SECTION("clear() forgets the free lists") {
+    DynamicJsonBuffer jb;
+    JsonArray& array = jb.createArray();
+    array.add(1);
+    array.remove(0);
+    jb.clear();
+
+    JsonArray& other = jb.createArray();
+    REQUIRE(other.add(1));
+    REQUIRE(1 == other.size());
+  }
+}
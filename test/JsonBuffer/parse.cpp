@@ -4,6 +4,7 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <sstream>
 
 using namespace Catch::Matchers;
 
@@ -77,4 +78,45 @@ TEST_CASE("JsonBuffer::parse()") {
     REQUIRE(variant.is<char*>());
     REQUIRE_THAT(variant.as<char*>(), Equals("hello"));
   }
+
+  SECTION("Long string") {
+    std::string expected(1000, 'x');
+    JsonVariant variant = jb.parse("\"" + expected + "\"");
+    REQUIRE(variant.success());
+    REQUIRE(expected == variant.as<char*>());
+  }
+
+  SECTION("Long string with escaped chars") {
+    const char* input =
+        "\"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+        "eiusmod\\ttempor incididunt ut labore et dolore magna aliqua.\\n"
+        "\\\"Ut enim ad minim veniam\\\", quis nostrud exercitation ullamco "
+        "laboris\"";
+    const char* expected =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+        "eiusmod\ttempor incididunt ut labore et dolore magna aliqua.\n"
+        "\"Ut enim ad minim veniam\", quis nostrud exercitation ullamco "
+        "laboris";
+
+    SECTION("const char*") {
+      JsonVariant variant = jb.parse(input);
+      REQUIRE(variant.success());
+      REQUIRE_THAT(variant.as<char*>(), Equals(expected));
+    }
+
+    SECTION("char[] (unescaped in place)") {
+      char buffer[256];
+      strcpy(buffer, input);
+      JsonVariant variant = jb.parse(buffer);
+      REQUIRE(variant.success());
+      REQUIRE_THAT(variant.as<char*>(), Equals(expected));
+    }
+
+    SECTION("std::istream") {
+      std::istringstream stream(input);
+      JsonVariant variant = jb.parse(stream);
+      REQUIRE(variant.success());
+      REQUIRE_THAT(variant.as<char*>(), Equals(expected));
+    }
+  }
 }
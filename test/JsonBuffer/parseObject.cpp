@@ -90,6 +90,30 @@ TEST_CASE("JsonBuffer::parseObject()") {
       REQUIRE(obj["key1"] == "value1");
       REQUIRE(obj["key2"] == "value2");
     }
+
+    SECTION("Long indentation") {
+      JsonObject& obj = jb.parseObject(
+          "{\n"
+          "                                        \"key1\" : \"value1\",\r\n"
+          "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\"key2\" : \"value2\"\n"
+          "                                                                }");
+      REQUIRE(obj.success());
+      REQUIRE(obj.size() == 2);
+      REQUIRE(obj["key1"] == "value1");
+      REQUIRE(obj["key2"] == "value2");
+    }
+
+    SECTION("Long comments") {
+      JsonObject& obj = jb.parseObject(
+          "{ /* a block comment that is longer than a SIMD register ** */\n"
+          "  \"key1\" : \"value1\", // a line comment that is long as well\n"
+          "  // another line comment\n"
+          "  \"key2\" : \"value2\" /***/ }");
+      REQUIRE(obj.success());
+      REQUIRE(obj.size() == 2);
+      REQUIRE(obj["key1"] == "value1");
+      REQUIRE(obj["key2"] == "value2");
+    }
   }
 
   SECTION("Values types") {
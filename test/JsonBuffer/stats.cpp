@@ -0,0 +1,72 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STATISTICS 1
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+TEST_CASE("JsonBuffer::stats()") {
+  SECTION("StaticJsonBuffer") {
+    StaticJsonBuffer<64> jb;
+    REQUIRE(0 == jb.stats().currentBytes);
+    REQUIRE(1 == jb.stats().blocks);
+
+    jb.alloc(1);
+    jb.alloc(8);
+    REQUIRE(2 == jb.stats().allocations);
+    REQUIRE(sizeof(void*) - 1 == jb.stats().paddingBytes);
+    REQUIRE(jb.size() == jb.stats().currentBytes);
+    REQUIRE(jb.size() == jb.stats().peakBytes);
+
+    jb.clear();
+    jb.alloc(1);
+    REQUIRE(1 == jb.stats().currentBytes);
+    REQUIRE(sizeof(void*) + 8 == jb.stats().peakBytes);
+    REQUIRE(3 == jb.stats().allocations);
+    REQUIRE(0 == jb.stats().paddingBytes);
+  }
+
+  SECTION("DynamicJsonBuffer") {
+    DynamicJsonBuffer jb(8);
+    REQUIRE(0 == jb.stats().blocks);
+
+    jb.alloc(8);
+    jb.alloc(16);
+    jb.alloc(32);
+    REQUIRE(3 == jb.stats().blocks);
+    REQUIRE(56 == jb.stats().currentBytes);
+    REQUIRE(56 == jb.stats().peakBytes);
+
+    jb.clear();
+    REQUIRE(0 == jb.stats().blocks);
+    REQUIRE(0 == jb.stats().currentBytes);
+    REQUIRE(56 == jb.stats().peakBytes);
+    REQUIRE(3 == jb.stats().allocations);
+  }
+
+  SECTION("counts the strings") {
+    DynamicJsonBuffer jb;
+    DynamicJsonBuffer::String str = jb.startString();
+    str.append("hello", 5);
+    str.c_str();
+    REQUIRE(6 == jb.stats().currentBytes);
+
+    str.discard();
+    REQUIRE(0 == jb.stats().currentBytes);
+    REQUIRE(6 == jb.stats().peakBytes);
+  }
+
+  SECTION("counts the nodes removed from arrays") {
+    DynamicJsonBuffer jb;
+    JsonArray& arr = jb.createArray();
+    arr.add(1);
+    arr.add(2);
+    REQUIRE(0 == jb.stats().orphanedBytes);
+
+    arr.remove(0);
+    REQUIRE(sizeof(Internals::ListNode<JsonVariant>) ==
+            jb.stats().orphanedBytes);
+  }
+}
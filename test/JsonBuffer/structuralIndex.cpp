@@ -0,0 +1,249 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace ArduinoJson::Internals;
+
+enum Method { PARSE, PARSE_ARRAY, PARSE_OBJECT };
+
+struct Result {
+  bool success;
+  std::string output;
+  size_t size;
+};
+
+template <typename TPolicy, typename TJsonBuffer, typename TInput>
+static Result parseWith(TJsonBuffer& jb, Method method, TInput input,
+                        uint8_t nestingLimit) {
+  JsonVariant variant;
+  switch (method) {
+    case PARSE:
+      variant = jb.template parse<TPolicy>(input, nestingLimit);
+      break;
+    case PARSE_ARRAY:
+      variant = jb.template parseArray<TPolicy>(input, nestingLimit);
+      break;
+    case PARSE_OBJECT:
+      variant = jb.template parseObject<TPolicy>(input, nestingLimit);
+      break;
+  }
+  Result result;
+  result.success = variant.success();
+  variant.printTo(result.output);
+  result.size = jb.size();
+  return result;
+}
+
+template <typename TJsonBuffer>
+static void checkBothParsersAgree(const std::string& json, Method method,
+                                  uint8_t nestingLimit) {
+  CAPTURE(json);
+  CAPTURE(method);
+  CAPTURE(nestingLimit);
+
+  // const char*
+  {
+    TJsonBuffer jb1, jb2;
+    Result expected = parseWith<DefaultParsing>(jb1, method, json.c_str(),
+                                                nestingLimit);
+    Result actual = parseWith<StructuralIndexParsing>(jb2, method,
+                                                      json.c_str(),
+                                                      nestingLimit);
+    REQUIRE(actual.success == expected.success);
+    REQUIRE(actual.output == expected.output);
+    REQUIRE(actual.size == expected.size);
+  }
+
+  // char[] (in place)
+  {
+    TJsonBuffer jb1, jb2;
+    std::vector<char> input1(json.begin(), json.end());
+    std::vector<char> input2(json.begin(), json.end());
+    input1.push_back('\0');
+    input2.push_back('\0');
+    Result expected =
+        parseWith<DefaultParsing>(jb1, method, &input1[0], nestingLimit);
+    Result actual = parseWith<StructuralIndexParsing>(jb2, method, &input2[0],
+                                                      nestingLimit);
+    REQUIRE(actual.success == expected.success);
+    REQUIRE(actual.output == expected.output);
+    REQUIRE(actual.size == expected.size);
+  }
+
+  // std::string
+  {
+    TJsonBuffer jb1, jb2;
+    Result expected =
+        parseWith<DefaultParsing>(jb1, method, json, nestingLimit);
+    Result actual =
+        parseWith<StructuralIndexParsing>(jb2, method, json, nestingLimit);
+    REQUIRE(actual.success == expected.success);
+    REQUIRE(actual.output == expected.output);
+    REQUIRE(actual.size == expected.size);
+  }
+}
+
+static void checkBothParsersAgree(const std::string& json) {
+  for (int method = PARSE; method <= PARSE_OBJECT; method++) {
+    for (uint8_t nestingLimit = 0; nestingLimit < 4; nestingLimit++) {
+      checkBothParsersAgree<DynamicJsonBuffer>(json, Method(method),
+                                               nestingLimit);
+      checkBothParsersAgree<StaticJsonBuffer<64> >(json, Method(method),
+                                                   nestingLimit);
+    }
+    checkBothParsersAgree<DynamicJsonBuffer>(json, Method(method), 10);
+  }
+}
+
+TEST_CASE("StructuralIndexParsing") {
+  SECTION("Same results as the default parser") {
+    const char* inputs[] = {
+        "",
+        "  ",
+        "-42",
+        "-1.23e+4",
+        "true",
+        "false",
+        "null",
+        "123abc",
+        "12#",
+        "\"hello world\"",
+        "\"hello",
+        "'hello world'",
+        "{",
+        "}",
+        "]",
+        "[",
+        "{}",
+        "[]",
+        "  []",
+        "{}123",
+        "%*$\xC2\xA3\xC2\xA4",
+        "[42]",
+        "[42,84]",
+        "[4.2,1e2]",
+        "[4294967295]",
+        "[ \t\r\n42]",
+        "[42 \t\r\n]",
+        "[,]",
+        "[1,]",
+        "[1#2]",
+        "[1 2]",
+        "[ab\"c\"]",
+        "[\"a\"b]",
+        "[\"a\" \"b\"]",
+        "[\\\"a\\\"]",
+        "[\"\",\"\"]",
+        "[\"]",
+        "[ \"hello\" , \"world\" ]",
+        "[ hello , world ]",
+        "[ 'hello' , 'world' ]",
+        "[\'\',\'\']",
+        "[null,null]",
+        "[true,false]",
+        "[\"1\\\"2\\\\3\\/4\\b5\\f6\\n7\\r8\\t9\"]",
+        "[\"\\\\\"]",
+        "[\"\\\\\\\"\"]",
+        "[\"\\",
+        "[[]]",
+        "[[[]]]",
+        "[[\"toto\"]]",
+        "[{\"toto\":1}]",
+        "[[[[[[[[[[[[[[[[[[[\"Not too deep\"]]]]]]]]]]]]]]]]]]]",
+        "[\"hello\"/*COMMENT*/,\"world\"]",
+        "[//COMMENT\n\"hello\"]",
+        "[/COMMENT\n]",
+        "{ \"key\":\"value\"}",
+        "{\"key\" :\"value\"}",
+        "{\"key\": \"value\"}",
+        "{\"key\":\"value\" }",
+        "{\"key1\":\"value1\" ,\"key2\":\"value2\"}",
+        "{\"key1\":42,\"key2\":-42}",
+        "{\"key1\":12.345,\"key2\":-7E89}",
+        "{\"key1\":true,\"key2\":false}",
+        "{\"key1\":null,\"key2\":null}",
+        "{\"key1\":\"value1\",}",
+        "{\"key\":{\"key\":{\"key\":42}}}",
+        "{\"toto\":[]}",
+        "{\"toto\":{}}",
+        "{key:value}",
+        "{_k_e_y_:42}",
+        "{key}",
+        "{\"key\"}",
+        "{\"a\":1,\"a\":2}",
+        "{a#:1}",
+        "{:1}",
+        "{'key':'value'}",
+        "null:\"value\"}",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      checkBothParsersAgree(inputs[i]);
+    }
+  }
+
+  SECTION("Every alignment and block boundary") {
+    const char* fragments[] = {
+        "{\"key\":\"value\",\"array\":[1,2.5,true,null,\"\\\\\"]}",
+        "[\"a\\\"b\",\"\\\\\\\\\",\"\\\\\\\"\",  \"tab\\tulation\"]",
+        "[\"unterminated",
+        "{\"key\":value}",
+    };
+    for (size_t i = 0; i < sizeof(fragments) / sizeof(fragments[0]); i++) {
+      for (size_t padding = 0; padding < 70; padding++) {
+        std::string json = std::string(padding, ' ') + "[" +
+                           std::string(padding % 7, ' ') + fragments[i] +
+                           "," + fragments[i] + "]";
+        checkBothParsersAgree<DynamicJsonBuffer>(json, PARSE, 10);
+        checkBothParsersAgree<DynamicJsonBuffer>(json, PARSE_ARRAY, 10);
+      }
+    }
+  }
+
+  SECTION("Large document") {
+    std::string json = "[";
+    for (int i = 0; i < 500; i++) {
+      if (i) json += ",\n  ";
+      json += "{\"id\":";
+      json += char('0' + i % 10);
+      json += ",\"name\":\"item \\\"";
+      json += std::string(size_t(i % 80), 'x');
+      json += "\\\"\",\"tags\":[\"a\",\"b\"],\"ok\":true}";
+    }
+    json += "]";
+    checkBothParsersAgree<DynamicJsonBuffer>(json, PARSE_ARRAY, 10);
+  }
+}
+
+TEST_CASE("StructuralIndex") {
+  StructuralIndex index;
+
+  SECTION("Operators, opening quotes and start of tokens") {
+    const char json[] = "{\"a\":[12, true],\"b\\\"]\" : x}";
+    REQUIRE(index.build(json));
+
+    const char expected[] = "{\":[1,t],\":x}";
+    REQUIRE(index.size() == strlen(expected));
+    for (size_t i = 0; i < index.size(); i++) {
+      REQUIRE(*index[i] == expected[i]);
+    }
+    REQUIRE(*index[index.size()] == '\0');
+  }
+
+  SECTION("Returns false for comments") {
+    REQUIRE_FALSE(index.build("[1,/*2*/3]"));
+  }
+
+  SECTION("Returns false for single quotes") {
+    REQUIRE_FALSE(index.build("['hello']"));
+  }
+
+  SECTION("Ignores slashes and single quotes in strings") {
+    REQUIRE(index.build("[\"/*'*/\"]"));
+    REQUIRE(index.size() == 3);
+  }
+}
@@ -0,0 +1,60 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+struct TrustedStructuralIndexParsing : DefaultParsing {
+  static const bool use_structural_index = true;
+  static const bool check_duplicate_keys = false;
+};
+
+template <typename TPolicy>
+static void testTrustedInput() {
+  DynamicJsonBuffer jb;
+
+  SECTION("Same tree as the default parser") {
+    const char* json = "{\"a\":1,\"b\":[true,{\"c\":\"d\"}],\"e\":{}}";
+    JsonObject& expected = jb.parseObject(json);
+    JsonObject& actual = jb.parseObject<TPolicy>(json);
+
+    REQUIRE(actual.success());
+    std::string expectedJson, actualJson;
+    expected.printTo(expectedJson);
+    actual.printTo(actualJson);
+    REQUIRE(expectedJson == actualJson);
+    REQUIRE(actual["b"][1]["c"] == std::string("d"));
+  }
+
+  SECTION("Keeps the duplicate keys") {
+    char json[] = "{\"a\":1,\"a\":2}";
+    JsonObject& obj = jb.parseObject<TPolicy>(json);
+
+    REQUIRE(2 == obj.size());
+    REQUIRE(1 == obj["a"]);
+  }
+
+  SECTION("Needs the same memory as the default parser") {
+    StaticJsonBuffer<JSON_OBJECT_SIZE(2)> staticBuffer;
+    char json[] = "{\"a\":1,\"b\":2}";
+    JsonObject& obj = staticBuffer.parseObject<TPolicy>(json);
+
+    REQUIRE(obj.success());
+    REQUIRE(2 == obj["b"]);
+  }
+
+  SECTION("Invalid input") {
+    REQUIRE_FALSE(jb.parseObject<TPolicy>("{\"a\":1,}").success());
+    REQUIRE_FALSE(jb.parseObject<TPolicy>("{\"a\"1}").success());
+  }
+}
+
+TEST_CASE("TrustedInputParsing") {
+  testTrustedInput<TrustedInputParsing>();
+}
+
+TEST_CASE("TrustedInputParsing with structural index") {
+  testTrustedInput<TrustedStructuralIndexParsing>();
+}
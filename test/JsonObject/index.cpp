@@ -0,0 +1,78 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+
+static const int largeSize = 10 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD + 7;
+
+static std::string keyOf(int i) {
+  char key[16];
+  sprintf(key, "key%d", i);
+  return key;
+}
+
+TEST_CASE("JsonObject index") {
+  DynamicJsonBuffer jb;
+  JsonObject& obj = jb.createObject();
+  for (int i = 0; i < largeSize; i++) obj[keyOf(i)] = i;
+
+  SECTION("finds every key") {
+    REQUIRE(largeSize == obj.size());
+    for (int i = 0; i < largeSize; i++) {
+      REQUIRE(i == obj[keyOf(i)]);
+      REQUIRE(i == obj.get<int>(keyOf(i).c_str()));
+    }
+    REQUIRE_FALSE(obj.containsKey("key"));
+    REQUIRE_FALSE(obj.containsKey(keyOf(largeSize)));
+  }
+
+  SECTION("set() replaces the existing values") {
+    for (int i = 0; i < largeSize; i++) obj.set(keyOf(i), -i);
+
+    REQUIRE(largeSize == obj.size());
+    for (int i = 0; i < largeSize; i++) REQUIRE(-i == obj[keyOf(i)]);
+  }
+
+  SECTION("remove() updates the index") {
+    for (int i = 0; i < largeSize; i += 2) obj.remove(keyOf(i));
+
+    REQUIRE(largeSize / 2 == obj.size());
+    for (int i = 0; i < largeSize; i++) {
+      REQUIRE((i % 2 == 1) == obj.containsKey(keyOf(i)));
+    }
+
+    for (int i = 0; i < largeSize; i += 2) obj[keyOf(i)] = i;
+    for (int i = 0; i < largeSize; i++) REQUIRE(i == obj[keyOf(i)]);
+  }
+
+  SECTION("the first duplicate key wins") {
+    obj.addNode("key1")->value = "duplicate";
+    REQUIRE(1 == obj["key1"]);
+
+    obj.remove("key1");
+    REQUIRE(std::string("duplicate") == obj["key1"].as<char*>());
+  }
+
+  SECTION("compactInto() copies the index") {
+    JsonVariant root = obj;
+    DynamicJsonBuffer destination;
+    JsonObject& copy = root.compactInto(destination).as<JsonObject>();
+
+    REQUIRE(root.compactSize() == destination.size());
+    for (int i = 0; i < largeSize; i++) REQUIRE(i == copy[keyOf(i)]);
+  }
+}
+
+TEST_CASE("JSON_OBJECT_SIZE() includes the index") {
+  static std::string keys[largeSize];
+  for (int i = 0; i < largeSize; i++) keys[i] = keyOf(i);
+
+  StaticJsonBuffer<JSON_OBJECT_SIZE(largeSize)> jb;
+  JsonObject& obj = jb.createObject();
+  for (int i = 0; i < largeSize; i++) REQUIRE(obj.set(keys[i].c_str(), i));
+
+  REQUIRE(largeSize - 1 == obj[keys[largeSize - 1].c_str()]);
+}
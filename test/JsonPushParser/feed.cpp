@@ -0,0 +1,126 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+typedef JsonPushParser<DynamicJsonBuffer> Parser;
+
+static void checkSameAsParse(const std::string& json, size_t chunkSize) {
+  CAPTURE(json);
+  CAPTURE(chunkSize);
+
+  DynamicJsonBuffer jb1;
+  JsonVariant expected = jb1.parse(json);
+  std::string expectedOutput;
+  expected.printTo(expectedOutput);
+
+  DynamicJsonBuffer jb2;
+  Parser parser(jb2);
+  for (size_t i = 0; i < json.size(); i += chunkSize) {
+    size_t n = json.size() - i < chunkSize ? json.size() - i : chunkSize;
+    if (parser.feed(json.data() + i, n) != Parser::NEED_MORE_DATA) break;
+  }
+  parser.finish();
+  JsonVariant actual = parser.root();
+  std::string actualOutput;
+  actual.printTo(actualOutput);
+
+  REQUIRE((parser.status() == Parser::COMPLETE) == expected.success());
+  REQUIRE(actualOutput == expectedOutput);
+}
+
+TEST_CASE("JsonPushParser::feed()") {
+  DynamicJsonBuffer jb;
+  Parser parser(jb);
+
+  SECTION("Same result as JsonBuffer::parse()") {
+    const char* inputs[] = {
+        "{}",
+        "[]",
+        "-42",
+        "true",
+        "\"hello world\"",
+        "'hello world'",
+        "\"hello",
+        "\"a\\\"b\\\\c\\n\\u0041\"",
+        "[42,84]",
+        "[ \t\r\n42 , 43 ]",
+        "[,]",
+        "[1,]",
+        "[1#2]",
+        "[1 2]",
+        "[\"a\"b]",
+        "[\"]",
+        "[ hello , world ]",
+        "[[[[\"deep\"]]]]",
+        "[{\"toto\":1}]",
+        "{\"key1\":\"value1\" ,\"key2\":\"value2\"}",
+        "{\"key1\":12.345,\"key2\":-7E89}",
+        "{key:value}",
+        "{_k_e_y_:42}",
+        "{'key':'value'}",
+        "{key}",
+        "{:1}",
+        "{\"key1\":\"value1\",}",
+        "{\"a\":1,\"a\":2}",
+        "/*COMMENT*/  [\"hello\"]",
+        "//COMMENT\n\t[\"hello\"]",
+        "[\"hello\"/*COMMENT*/,\"world\"]",
+        "[\"hello\"//COMMENT\n,\"world\"]",
+        "[/*/\n]",
+        "[/*COMMENT]",
+        "[//COMMENT",
+        "[/COMMENT\n]",
+        "/x",
+        "{}123",
+        "",
+        "]",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      checkSameAsParse(inputs[i], 1);
+      checkSameAsParse(inputs[i], 3);
+      checkSameAsParse(inputs[i], 1000);
+    }
+  }
+
+  SECTION("NEED_MORE_DATA until the root is complete") {
+    REQUIRE(parser.feed("{\"hel", 5) == Parser::NEED_MORE_DATA);
+    REQUIRE(parser.feed("lo\":[1", 6) == Parser::NEED_MORE_DATA);
+    REQUIRE(parser.feed(",2]", 3) == Parser::NEED_MORE_DATA);
+    REQUIRE(parser.feed("}", 1) == Parser::COMPLETE);
+
+    JsonObject& obj = parser.root();
+    REQUIRE(obj["hello"][1] == 2);
+  }
+
+  SECTION("Ignores what follows the root") {
+    REQUIRE(parser.feed("[1][2]", 6) == Parser::COMPLETE);
+    REQUIRE(parser.feed("[3]", 3) == Parser::COMPLETE);
+    REQUIRE(parser.root().as<JsonArray>()[0] == 1);
+  }
+
+  SECTION("Number is complete after a delimiter") {
+    REQUIRE(parser.feed("42", 2) == Parser::NEED_MORE_DATA);
+    REQUIRE(parser.feed(" ", 1) == Parser::COMPLETE);
+    REQUIRE(parser.root() == 42);
+  }
+
+  SECTION("PARSE_ERROR") {
+    REQUIRE(parser.feed("[1}", 3) == Parser::PARSE_ERROR);
+    REQUIRE(parser.feed("]", 1) == Parser::PARSE_ERROR);
+  }
+
+  SECTION("Nesting limit") {
+    JsonPushParser<DynamicJsonBuffer, 2> limited(jb);
+    REQUIRE(limited.feed("[[[]]]", 6) == Parser::PARSE_ERROR);
+  }
+
+  SECTION("Out of memory") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(1)> sjb;
+    JsonPushParser<StaticJsonBuffer<JSON_ARRAY_SIZE(1)> > small(sjb);
+    REQUIRE(small.feed("[1,2]", 5) == Parser::PARSE_ERROR);
+  }
+}
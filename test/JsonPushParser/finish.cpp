@@ -0,0 +1,40 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+typedef JsonPushParser<DynamicJsonBuffer> Parser;
+
+TEST_CASE("JsonPushParser::finish()") {
+  DynamicJsonBuffer jb;
+  Parser parser(jb);
+
+  SECTION("Completes a number") {
+    parser.feed("-42", 3);
+    REQUIRE(parser.finish() == Parser::COMPLETE);
+    REQUIRE(parser.root() == -42);
+  }
+
+  SECTION("Completes an unterminated string") {
+    parser.feed("\"hello", 6);
+    REQUIRE(parser.finish() == Parser::COMPLETE);
+    REQUIRE(parser.root() == std::string("hello"));
+  }
+
+  SECTION("Fails on an unterminated array") {
+    parser.feed("[1,2", 4);
+    REQUIRE(parser.finish() == Parser::PARSE_ERROR);
+  }
+
+  SECTION("Fails on an unterminated comment") {
+    parser.feed("[1/*", 4);
+    REQUIRE(parser.finish() == Parser::PARSE_ERROR);
+  }
+
+  SECTION("Keeps COMPLETE") {
+    parser.feed("{}", 2);
+    REQUIRE(parser.finish() == Parser::COMPLETE);
+  }
+}
@@ -230,3 +230,74 @@ TEST_CASE("JsonVariant::as()") {
     REQUIRE(&arr == &variant.as<JsonObject>());  // <- shorthand
   }
 }
+
+TEST_CASE("JsonVariant::as(T&)") {
+  DynamicJsonBuffer jb;
+
+  SECTION("PositiveLong") {
+    JsonVariant variant = 42L;
+    long value = 0;
+    REQUIRE(variant.as(value));
+    REQUIRE(42L == value);
+  }
+
+  SECTION("NegativeLongAsUnsigned") {
+    JsonVariant variant = -42L;
+    unsigned long value = 666;
+    REQUIRE_FALSE(variant.as(value));
+    REQUIRE(666 == value);
+  }
+
+  SECTION("LongAsTooSmallType") {
+    JsonVariant variant = 300L;
+    uint8_t value = 0;
+    REQUIRE_FALSE(variant.as(value));
+    REQUIRE(44 == variant.as<uint8_t>());  // <- wraps around
+  }
+
+  SECTION("NumberStringAsShort") {
+    JsonVariant variant = RawJson("-32768");
+    int16_t value = 0;
+    REQUIRE(variant.as(value));
+    REQUIRE(-32768 == value);
+  }
+
+  SECTION("TooBigNumberStringAsShort") {
+    JsonVariant variant = RawJson("32768");
+    int16_t value = 0;
+    REQUIRE_FALSE(variant.as(value));
+  }
+
+  SECTION("TooBigNumberStringAsLong") {
+    JsonVariant variant = RawJson("123456789012345678901234567890");
+    long value = 0;
+    REQUIRE_FALSE(variant.as(value));
+  }
+
+  SECTION("DoubleAsLong") {
+    JsonVariant variant = 4.2;
+    long value = 0;
+    REQUIRE_FALSE(variant.as(value));
+  }
+
+  SECTION("TrueAsLong") {
+    JsonVariant variant = true;
+    long value = 0;
+    REQUIRE_FALSE(variant.as(value));
+  }
+
+  SECTION("Subscripts") {
+    JsonObject& obj = jb.parseObject("{\"id\":1234567890123,\"list\":[1,-1]}");
+    REQUIRE(obj.success());
+
+    uint8_t id8 = 0;
+    REQUIRE_FALSE(obj["id"].as(id8));
+    uint8_t first = 0;
+    REQUIRE(obj["list"][0].as(first));
+    REQUIRE(1 == first);
+    uint8_t second = 0;
+    REQUIRE_FALSE(obj["list"][1].as(second));
+    int missing = 0;
+    REQUIRE_FALSE(obj["missing"].as(missing));
+  }
+}
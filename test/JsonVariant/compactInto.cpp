@@ -0,0 +1,96 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static std::string serialize(const JsonVariant& variant) {
+  std::string json;
+  variant.printTo(json);
+  return json;
+}
+
+TEST_CASE("JsonVariant::compactInto()") {
+  DynamicJsonBuffer source;
+  DynamicJsonBuffer destination;
+
+  SECTION("Integer") {
+    JsonVariant copy = JsonVariant(42).compactInto(destination);
+
+    REQUIRE(42 == copy.as<int>());
+    REQUIRE(0 == JsonVariant(42).compactSize());
+    REQUIRE(0 == destination.size());
+  }
+
+  SECTION("String") {
+    char hello[] = "hello";
+    JsonVariant copy = JsonVariant(hello).compactInto(destination);
+    hello[0] = 'j';
+
+    REQUIRE(std::string("hello") == copy.as<const char*>());
+    REQUIRE(6 == destination.size());
+  }
+
+  SECTION("Document") {
+    char json[] =
+        "{\"a\":[1,2.5,true,null,\"x\"],\"b\":{\"c\":\"d\",\"e\":[]},\"f\":-3}";
+    JsonObject& root = source.parseObject(json);
+    REQUIRE(root.success());
+
+    JsonVariant copy = JsonVariant(root).compactInto(destination);
+
+    REQUIRE(serialize(root) == serialize(copy));
+    REQUIRE(JsonVariant(root).compactSize() == destination.size());
+    REQUIRE(copy["a"][1] == 2.5);
+    REQUIRE(copy["a"][3].as<const char*>() == 0);
+  }
+
+  SECTION("Doesn't reference the source") {
+    JsonObject& root = source.createObject();
+    root["key"] = std::string("value");
+    JsonVariant copy = JsonVariant(root).compactInto(destination);
+    root["key"] = std::string("other");
+    source.clear();
+
+    REQUIRE(std::string("{\"key\":\"value\"}") == serialize(copy));
+  }
+
+  SECTION("Allocates the nodes in traversal order") {
+    char json[] = "[[1],{\"a\":2},[3]]";
+    JsonArray& root = source.parseArray(json);
+
+    DynamicJsonBuffer largeBuffer(1024);  // everything in one block
+    JsonArray& copy =
+        JsonVariant(root).compactInto(largeBuffer).as<JsonArray>();
+
+    const void* first = &copy[0].as<JsonArray>();
+    const void* second = &copy[1].as<JsonObject>();
+    const void* third = &copy[2].as<JsonArray>();
+    REQUIRE(&copy < first);
+    REQUIRE(first < second);
+    REQUIRE(second < third);
+  }
+
+  SECTION("Fits exactly in a StaticJsonBuffer") {
+    char json[] = "{\"hello\":[\"world\",42]}";
+    JsonObject& root = source.parseObject(json);
+    REQUIRE(JsonVariant(root).compactSize() <= 256);
+
+    StaticJsonBuffer<256> staticBuffer;
+    JsonVariant copy = JsonVariant(root).compactInto(staticBuffer);
+
+    REQUIRE(JsonVariant(root).compactSize() == staticBuffer.size());
+    REQUIRE(serialize(root) == serialize(copy));
+  }
+
+  SECTION("Fails when the buffer is too small") {
+    char json[] = "{\"hello\":[\"world\",42]}";
+    JsonObject& root = source.parseObject(json);
+
+    StaticJsonBuffer<32> staticBuffer;
+    JsonVariant copy = JsonVariant(root).compactInto(staticBuffer);
+
+    REQUIRE_FALSE(copy.success());
+  }
+}
@@ -0,0 +1,109 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_NAN_BOXING 1
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <limits>
+
+template <typename T>
+static std::string print(T value) {
+  std::string json;
+  JsonVariant(value).printTo(json);
+  return json;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_NAN_BOXING") {
+  SECTION("JsonVariant takes 8 bytes") {
+    REQUIRE(8 == sizeof(JsonVariant));
+  }
+
+  SECTION("Undefined") {
+    JsonVariant variant;
+    REQUIRE_FALSE(variant.success());
+    REQUIRE(0 == variant.as<int>());
+  }
+
+  SECTION("Doubles") {
+    REQUIRE(3.14 == JsonVariant(3.14).as<double>());
+    REQUIRE(-3.14 == JsonVariant(-3.14).as<double>());
+    REQUIRE(JsonVariant(1e300).is<double>());
+    REQUIRE("-1e300" == print(-1e300));
+  }
+
+  SECTION("Infinity and NaN") {
+    double inf = std::numeric_limits<double>::infinity();
+    REQUIRE(inf == JsonVariant(inf).as<double>());
+    REQUIRE(-inf == JsonVariant(-inf).as<double>());
+    REQUIRE(JsonVariant(-inf).is<double>());
+
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    REQUIRE(JsonVariant(nan).is<double>());
+    REQUIRE(JsonVariant(-nan).is<double>());
+    REQUIRE("NaN" == print(-nan));
+  }
+
+  SECTION("Booleans") {
+    REQUIRE(JsonVariant(true).as<bool>());
+    REQUIRE(JsonVariant(false).is<bool>());
+    REQUIRE("false" == print(false));
+  }
+
+  // The integers of 64 bits
+#if ARDUINOJSON_USE_LONG_LONG || ARDUINOJSON_USE_INT64 || defined(__LP64__)
+  typedef Internals::JsonInteger Integer;
+
+  SECTION("Integers up to 48 bits") {
+    Integer max = (Integer(1) << 48) - 1;
+    REQUIRE(max == JsonVariant(max).as<Integer>());
+    REQUIRE(-max == JsonVariant(-max).as<Integer>());
+    REQUIRE(JsonVariant(max).is<Integer>());
+    REQUIRE("-281474976710655" == print(-max));
+  }
+
+  SECTION("Larger integers become doubles") {
+    Integer big = Integer(1) << 60;
+    REQUIRE(JsonVariant(big).is<double>());
+    REQUIRE_FALSE(JsonVariant(big).is<Integer>());
+    REQUIRE(big == JsonVariant(big).as<Integer>());
+    REQUIRE(-big == JsonVariant(-big).as<Integer>());
+  }
+#endif
+
+  SECTION("Strings") {
+    REQUIRE(std::string("hello") == JsonVariant("hello").as<const char*>());
+    REQUIRE(NULL == JsonVariant(static_cast<const char*>(0)).as<char*>());
+    REQUIRE("\"hello\"" == print("hello"));
+  }
+
+  SECTION("Unparsed values are classified") {
+    DynamicJsonBuffer jb;
+    JsonArray& array = jb.parseArray("[42,-1.5,true,null,\"hi\"]");
+    REQUIRE(array[0].is<int>());
+    REQUIRE(42 == array[0].as<int>());
+    REQUIRE(-1.5 == array[1].as<double>());
+    REQUIRE(array[2].as<bool>());
+    REQUIRE(array[3].as<char*>() == NULL);
+    REQUIRE(std::string("hi") == array[4].as<char*>());
+
+    std::string json;
+    array.printTo(json);
+    REQUIRE("[42,-1.5,true,null,\"hi\"]" == json);
+  }
+
+  SECTION("Arrays and objects") {
+    DynamicJsonBuffer jb;
+    JsonObject& object = jb.parseObject("{\"a\":[1,{\"b\":2}]}");
+    JsonVariant variant = object;
+    REQUIRE(&object == &variant.as<JsonObject>());
+    REQUIRE(2 == variant["a"][1]["b"].as<int>());
+    REQUIRE(variant.compactSize() == variant.compactInto(jb).compactSize());
+  }
+
+  SECTION("The nodes are smaller") {
+    REQUIRE(2 * sizeof(void*) == sizeof(JsonArray::node_type));
+    REQUIRE(3 * sizeof(void*) == sizeof(JsonObject::node_type));
+  }
+}
@@ -0,0 +1,125 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_SMALL_STRINGS 1
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+// Tells whether the string is stored in the variant itself
+static bool isInVariant(const JsonVariant& variant) {
+  const char* s = variant.as<const char*>();
+  const char* v = reinterpret_cast<const char*>(&variant);
+  return v <= s && s < v + sizeof(variant);
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_SMALL_STRINGS") {
+  DynamicJsonBuffer jb;
+
+  SECTION("JsonVariant has the same size") {
+    REQUIRE(sizeof(void*) + sizeof(Internals::JsonUInt) >= sizeof(JsonVariant));
+  }
+
+  SECTION("JsonArray::add() copies the small strings in the node") {
+    JsonArray& array = jb.createArray();
+    array.add(std::string("1234567"));
+
+    REQUIRE(JSON_ARRAY_SIZE(1) == jb.size());
+    REQUIRE(isInVariant(array[0]));
+    REQUIRE(std::string("1234567") == array[0].as<const char*>());
+    REQUIRE(array[0].is<const char*>());
+  }
+
+  SECTION("JsonArray::add() allocates the longer strings") {
+    JsonArray& array = jb.createArray();
+    array.add(std::string("12345678"));
+
+    REQUIRE(JSON_ARRAY_SIZE(1) + 9 == jb.size());
+    REQUIRE_FALSE(isInVariant(array[0]));
+    REQUIRE(std::string("12345678") == array[0].as<const char*>());
+  }
+
+  SECTION("JsonObject::set() copies the value but allocates the key") {
+    JsonObject& object = jb.createObject();
+    object.set(std::string("id"), std::string("ok"));
+
+    REQUIRE(JSON_OBJECT_SIZE(1) + 3 == jb.size());
+    REQUIRE(isInVariant(object["id"]));
+    REQUIRE(object["id"] == "ok");
+  }
+
+  SECTION("The pointers to const char are not copied") {
+    const char* hello = "hello";
+    JsonArray& array = jb.createArray();
+    array.add(hello);
+
+    REQUIRE(hello == array[0].as<const char*>());
+  }
+
+  SECTION("A copy of the variant has its own string") {
+    JsonArray& array = jb.createArray();
+    array.add(std::string("ok"));
+    JsonVariant copy = array[0];
+
+    REQUIRE(isInVariant(copy));
+    REQUIRE(copy == "ok");
+    REQUIRE(copy.as<const char*>() != array[0].as<const char*>());
+  }
+
+  SECTION("A parsed string is in the returned variant") {
+    // as<const char*>() on the temporary returned by parse() would dangle
+    JsonVariant variant = jb.parse("\"ok\"");
+
+    REQUIRE(isInVariant(variant));
+    REQUIRE(variant == "ok");
+    REQUIRE(0 == jb.size());
+  }
+
+  SECTION("The parser copies the small strings in the nodes") {
+    const std::string json = "[\"ok\",\"not a short one\",42,true,null]";
+    JsonArray& array = jb.parseArray(json);
+
+    REQUIRE(JSON_ARRAY_SIZE(5) + 16 == jb.size());
+    REQUIRE(array[0] == "ok");
+    REQUIRE(isInVariant(array[0]));
+    REQUIRE(array[1] == "not a short one");
+    REQUIRE(42 == array[2].as<int>());
+    REQUIRE(array[2].is<int>());
+    REQUIRE(array[3].as<bool>());
+    REQUIRE(array[4].as<char*>() == NULL);
+
+    std::string output;
+    array.printTo(output);
+    REQUIRE("[\"ok\",\"not a short one\",42,true,null]" == output);
+  }
+
+  SECTION("The parser copies the small strings of a writable input") {
+    char json[] = "{\"status\":\"ok\",\"code\":\"1234567\"}";
+    JsonObject& object = jb.parseObject(json);
+
+    REQUIRE(object["status"] == "ok");
+    REQUIRE(object["code"] == "1234567");
+    REQUIRE(std::string("status") == object.begin()->key);
+  }
+
+  SECTION("compactInto() doesn't allocate the small strings") {
+    JsonArray& array = jb.parseArray("[\"ok\",\"not a short one\"]");
+    JsonVariant variant = array;
+    DynamicJsonBuffer jb2;
+    JsonVariant copy = variant.compactInto(jb2);
+
+    REQUIRE(JSON_ARRAY_SIZE(2) + 16 == variant.compactSize());
+    REQUIRE(variant.compactSize() == jb2.size());
+    REQUIRE(copy[0] == "ok");
+    REQUIRE(copy[1] == "not a short one");
+  }
+
+  SECTION("as<std::string>()") {
+    JsonArray& array = jb.createArray();
+    array.add(std::string(""));
+
+    REQUIRE("" == array[0].as<std::string>());
+    REQUIRE(JSON_ARRAY_SIZE(1) == jb.size());
+  }
+}
@@ -0,0 +1,124 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string.h>
+#include <string>
+
+// Everything that the variant tells about an unparsed string
+struct Observations {
+  bool isBool, isInt, isDouble, isString;
+  bool asBool;
+  long asLong;
+  std::string asDouble, asString, json;
+
+  bool operator==(const Observations& other) const {
+    return isBool == other.isBool && isInt == other.isInt &&
+           isDouble == other.isDouble && isString == other.isString &&
+           asBool == other.asBool && asLong == other.asLong &&
+           asDouble == other.asDouble && asString == other.asString &&
+           json == other.json;
+  }
+};
+
+// Each query is made on a fresh variant
+static Observations observeFresh(const char* raw) {
+  Observations o;
+  o.isBool = JsonVariant(RawJson(raw)).is<bool>();
+  o.isInt = JsonVariant(RawJson(raw)).is<int>();
+  o.isDouble = JsonVariant(RawJson(raw)).is<double>();
+  o.isString = JsonVariant(RawJson(raw)).is<const char*>();
+  o.asBool = JsonVariant(RawJson(raw)).as<bool>();
+  o.asLong = JsonVariant(RawJson(raw)).as<long>();
+  JsonVariant(JsonVariant(RawJson(raw)).as<double>()).printTo(o.asDouble);
+  const char* s = JsonVariant(RawJson(raw)).as<const char*>();
+  o.asString = s ? s : "(null)";
+  JsonVariant(RawJson(raw)).printTo(o.json);
+  return o;
+}
+
+// All the queries are made on the same variant
+static Observations observe(const JsonVariant& variant) {
+  Observations o;
+  o.isBool = variant.is<bool>();
+  o.isInt = variant.is<int>();
+  o.isDouble = variant.is<double>();
+  o.isString = variant.is<const char*>();
+  o.asBool = variant.as<bool>();
+  o.asLong = variant.as<long>();
+  JsonVariant(variant.as<double>()).printTo(o.asDouble);
+  const char* s = variant.as<const char*>();
+  o.asString = s ? s : "(null)";
+  variant.printTo(o.json);
+  return o;
+}
+
+TEST_CASE("JsonVariant with an unparsed string") {
+  const char* inputs[] = {"null", "true", "false", "42",   "-42", "+42",
+                          "3.14", "1e3",  "-",     "+",    ".",   "NaN",
+                          "-Infinity",    "hello", "123abc", ""};
+
+  SECTION("Repeated queries give the same results") {
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      CAPTURE(inputs[i]);
+      Observations expected = observeFresh(inputs[i]);
+
+      JsonVariant variant = RawJson(inputs[i]);
+      REQUIRE(observe(variant) == expected);
+      REQUIRE(observe(variant) == expected);
+
+      JsonVariant copy = variant;
+      REQUIRE(observe(copy) == expected);
+    }
+  }
+
+  SECTION("The parser classifies the values") {
+    DynamicJsonBuffer jb;
+    char json[] = "[42,3.14,true,null,hello]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(arr.success());
+
+    REQUIRE(arr[0].is<int>());
+    REQUIRE(arr[1].is<double>());
+    REQUIRE(arr[2].is<bool>());
+    REQUIRE(arr[3].is<const char*>());
+    REQUIRE_FALSE(arr[4].is<int>());
+
+    // the text is still there
+    REQUIRE(std::string("42") == arr[0].as<const char*>());
+    REQUIRE(arr[0].is<int>());
+    REQUIRE(42 == arr[0].as<int>());
+    REQUIRE(3.14 == arr[1].as<double>());
+    REQUIRE(arr[2].as<bool>());
+    REQUIRE(arr[3].as<const char*>() == 0);
+    std::string output;
+    arr.printTo(output);
+    REQUIRE(output == "[42,3.14,true,null,hello]");
+  }
+
+  SECTION("The conversions don't modify the variant") {
+    DynamicJsonBuffer jb;
+    char json[] = "[42,3.14,true,null,hello]";
+    const JsonArray& arr = jb.parseArray(json);
+
+    for (JsonArray::const_iterator it = arr.begin(); it != arr.end(); ++it) {
+      unsigned char before[sizeof(JsonVariant)];
+      memcpy(before, &*it, sizeof(JsonVariant));
+
+      observe(*it);
+
+      REQUIRE(0 == memcmp(before, &*it, sizeof(JsonVariant)));
+    }
+  }
+
+  SECTION("NULL") {
+    JsonVariant variant = RawJson(static_cast<const char*>(0));
+    REQUIRE_FALSE(variant.is<int>());
+    REQUIRE_FALSE(variant.is<double>());
+    REQUIRE_FALSE(variant.is<bool>());
+    REQUIRE_FALSE(variant.is<const char*>());
+    REQUIRE(variant.as<const char*>() == 0);
+  }
+}
@@ -0,0 +1,128 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+struct EventLogger : JsonHandler {
+  std::string log;
+
+  bool startObject() {
+    log += "{";
+    return true;
+  }
+  bool endObject() {
+    log += "}";
+    return true;
+  }
+  bool startArray() {
+    log += "[";
+    return true;
+  }
+  bool endArray() {
+    log += "]";
+    return true;
+  }
+  bool key(const char* s) {
+    log += "key:" + std::string(s) + " ";
+    return true;
+  }
+  bool string(const char* s) {
+    log += "string:" + std::string(s) + " ";
+    return true;
+  }
+  bool number(const char* s) {
+    log += "number:" + std::string(s) + " ";
+    return true;
+  }
+  bool boolean(bool b) {
+    log += b ? "true " : "false ";
+    return true;
+  }
+  bool null() {
+    log += "null ";
+    return true;
+  }
+};
+
+// Stops at the first key "stop"
+struct Router : JsonHandler {
+  int keys;
+  Router() : keys(0) {}
+
+  bool key(const char* s) {
+    keys++;
+    return strcmp(s, "stop") != 0;
+  }
+};
+
+TEST_CASE("parseJsonEvents()") {
+  EventLogger logger;
+
+  SECTION("Object") {
+    REQUIRE(parseJsonEvents(
+        "{\"a\":1,\"b\":[true,false,null],\"c\":\"x\\ty\",d:-1.5e3}", logger));
+    REQUIRE(logger.log ==
+            "{key:a number:1 key:b [true false null ]key:c string:x\ty "
+            "key:d number:-1.5e3 }");
+  }
+
+  SECTION("Non-quoted string") {
+    REQUIRE(parseJsonEvents("[hello]", logger));
+    REQUIRE(logger.log == "[string:hello ]");
+  }
+
+  SECTION("Comments") {
+    REQUIRE(parseJsonEvents("[/*a*/1//b\n]", logger));
+    REQUIRE(logger.log == "[number:1 ]");
+  }
+
+  SECTION("Invalid input") {
+    REQUIRE_FALSE(parseJsonEvents("[1,2", logger));
+    REQUIRE(logger.log == "[number:1 number:2 ");
+  }
+
+  SECTION("Nesting limit") {
+    REQUIRE(parseJsonEvents("[[]]", logger, 2));
+    REQUIRE_FALSE(parseJsonEvents("[[]]", logger, 1));
+  }
+
+  SECTION("Writable input is unescaped in place") {
+    char json[] = "[\"a\\nb\"]";
+    REQUIRE(parseJsonEvents(json, logger));
+    REQUIRE(logger.log == "[string:a\nb ]");
+    REQUIRE(std::string(json) == "a\nb");
+  }
+
+  SECTION("std::string") {
+    std::string json = "{\"key\":\"value\"}";
+    REQUIRE(parseJsonEvents(json, logger));
+    REQUIRE(logger.log == "{key:key string:value }");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream json("[42]");
+    REQUIRE(parseJsonEvents(json, logger));
+    REQUIRE(logger.log == "[number:42 ]");
+  }
+
+  SECTION("String too long for a read-only input") {
+    std::string json = "\"" + std::string(ARDUINOJSON_EVENT_STRING_SIZE, 'x') +
+                       "\"";
+    REQUIRE_FALSE(parseJsonEvents(json, logger));
+  }
+
+  SECTION("The handler stops the parsing") {
+    Router router;
+    REQUIRE_FALSE(parseJsonEvents("{\"a\":1,\"stop\":2,\"c\":3}", router));
+    REQUIRE(router.keys == 2);
+  }
+
+  SECTION("Default handler ignores everything") {
+    JsonHandler handler;
+    REQUIRE(parseJsonEvents("{\"a\":[1,2,{\"b\":null}]}", handler));
+  }
+}
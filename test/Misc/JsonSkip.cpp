@@ -0,0 +1,93 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+static std::string rest(const char* json) {
+  const char* end = skipJson(json);
+  return end ? end : "(null)";
+}
+
+TEST_CASE("skipJson()") {
+  SECTION("Literals") {
+    REQUIRE(rest("42,1") == ",1");
+    REQUIRE(rest("  -1.5e3]") == "]");
+    REQUIRE(rest("true}") == "}");
+    REQUIRE(rest("") == "");
+  }
+
+  SECTION("Strings") {
+    REQUIRE(rest("\"hello\",1") == ",1");
+    REQUIRE(rest("'hello',1") == ",1");
+    REQUIRE(rest("\"a\\\"]\\\\\",1") == ",1");
+    REQUIRE(rest("\"[{,'\",1") == ",1");
+    REQUIRE(rest("\"unterminated") == "");
+    REQUIRE(rest("\"ends with \\") == "");
+  }
+
+  SECTION("Containers") {
+    REQUIRE(rest("[],1") == ",1");
+    REQUIRE(rest("{} ,1") == " ,1");
+    REQUIRE(rest("[1,[2,3],{\"a\":[\"]\"]}],1") == ",1");
+    REQUIRE(rest("{ a : 1 , /* } */ 'b' : { } }x") == "x");
+    REQUIRE(rest("[//]\n1]x") == "x");
+  }
+
+  SECTION("Long strings") {
+    std::string json = "[\"" + std::string(1000, 'x') + "\\\"" +
+                       std::string(1000, ']') + "\"]x";
+    REQUIRE(rest(json.c_str()) == "x");
+  }
+
+  SECTION("Invalid values") {
+    REQUIRE(rest("[1 2]") == "(null)");
+    REQUIRE(rest("[1,2") == "(null)");
+    REQUIRE(rest("{\"a\"}") == "(null)");
+    REQUIRE(rest("{\"a\":1;}") == "(null)");
+    REQUIRE(skipJson(NULL) == NULL);
+  }
+
+  SECTION("Nesting limit") {
+    REQUIRE(skipJson("[[]]", 2) != NULL);
+    REQUIRE(skipJson("[[]]", 1) == NULL);
+    REQUIRE(skipJson("{\"a\":{}}", 1) == NULL);
+    REQUIRE(skipJson("42", 0) != NULL);
+  }
+}
+
+TEST_CASE("findJsonElement()") {
+  const char* json = " [ {\"id\":0} , \"[1]\" , [2] , 3 ] ";
+
+  SECTION("First element") {
+    REQUIRE(std::string(findJsonElement(json, 0)) ==
+            "{\"id\":0} , \"[1]\" , [2] , 3 ] ");
+  }
+
+  SECTION("Middle element") {
+    REQUIRE(std::string(findJsonElement(json, 2)) == "[2] , 3 ] ");
+  }
+
+  SECTION("Last element") {
+    REQUIRE(std::string(findJsonElement(json, 3)) == "3 ] ");
+  }
+
+  SECTION("Out of range") {
+    REQUIRE(findJsonElement(json, 4) == NULL);
+    REQUIRE(findJsonElement("[]", 0) == NULL);
+  }
+
+  SECTION("Not an array") {
+    REQUIRE(findJsonElement("{}", 0) == NULL);
+    REQUIRE(findJsonElement(NULL, 0) == NULL);
+  }
+
+  SECTION("Can be parsed") {
+    DynamicJsonBuffer jb;
+    JsonArray& arr = jb.parseArray(findJsonElement(json, 2));
+    REQUIRE(arr.size() == 1);
+    REQUIRE(arr[0] == 2);
+  }
+}
@@ -0,0 +1,81 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+#include <fstream>
+#include <string>
+
+static void writeFile(const char* path, const std::string& content) {
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+TEST_CASE("MappedFile") {
+  const char* path = "MappedFile.json";
+  DynamicJsonBuffer jb;
+
+  SECTION("parseObject()") {
+    writeFile(path, "{\"hello\":\"world\",\"answer\":42}");
+    MappedFile file(path);
+    REQUIRE(file.success());
+    REQUIRE(file.size() == 29);
+
+    JsonObject& obj = jb.parseObject(file);
+    REQUIRE(obj.success());
+    REQUIRE(obj["hello"] == std::string("world"));
+    REQUIRE(obj["answer"] == 42);
+  }
+
+  SECTION("parseArray<StructuralIndexParsing>()") {
+    writeFile(path, "[1,2,3]");
+    MappedFile file(path);
+
+    JsonArray& arr = jb.parseArray<StructuralIndexParsing>(file);
+    REQUIRE(arr.success());
+    REQUIRE(arr.size() == 3);
+  }
+
+  SECTION("Size is a multiple of the page size") {
+    std::string json = "[\"" + std::string(4096 - 4, 'x') + "\"]";
+    writeFile(path, json);
+    MappedFile file(path);
+    REQUIRE(file.size() == 4096);
+    REQUIRE(file.c_str()[4096] == '\0');
+
+    JsonArray& arr = jb.parseArray(file);
+    REQUIRE(arr.success());
+    REQUIRE(strlen(arr[0]) == 4092);
+  }
+
+  SECTION("Empty file") {
+    writeFile(path, "");
+    MappedFile file(path);
+    REQUIRE(file.success());
+    REQUIRE(file.c_str() == std::string(""));
+
+    REQUIRE_FALSE(jb.parseObject(file).success());
+  }
+
+  SECTION("Missing file") {
+    MappedFile file("MappedFile.missing");
+    REQUIRE_FALSE(file.success());
+    REQUIRE(file.c_str() == NULL);
+
+    REQUIRE_FALSE(jb.parseObject(file).success());
+  }
+
+  SECTION("Strings are copied") {
+    writeFile(path, "{\"hello\":\"world\"}");
+    JsonObject* obj;
+    {
+      MappedFile file(path);
+      obj = &jb.parseObject(file);
+    }
+    REQUIRE((*obj)["hello"] == std::string("world"));
+  }
+
+  remove(path);
+}
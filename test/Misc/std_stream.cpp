@@ -81,4 +81,70 @@ TEST_CASE("std::stream") {
     jsonBuffer.parseObject(json);
     REQUIRE('1' == json.get());
   }
+
+  SECTION("ShouldNotReadPastTheEndOfALongDocument") {
+    std::string doc = "[\"" + std::string(3000, 'x') + "\"]";
+    std::istringstream json(doc + "123");
+    DynamicJsonBuffer jsonBuffer;
+    REQUIRE(jsonBuffer.parseArray(json).success());
+    REQUIRE('1' == json.get());
+  }
+
+  SECTION("ShouldNotReadPastTheEndOfANonSeekableStream") {
+    struct NonSeekableBuffer : std::streambuf {
+      NonSeekableBuffer(char* s, size_t n) {
+        setg(s, s, s + n);
+      }
+    };
+    char input[] = "{}123";
+    NonSeekableBuffer buffer(input, 5);
+    std::istream json(&buffer);
+    DynamicJsonBuffer jsonBuffer;
+    REQUIRE(jsonBuffer.parseObject(json).success());
+    REQUIRE('1' == json.get());
+  }
+
+  SECTION("DoesNotWaitForMoreInputThanTheDocument") {
+    // Gives one document each time the buffer is empty, like a pipe whose
+    // writer sends them one by one
+    struct PipeBuffer : std::streambuf {
+      PipeBuffer() : first("{\"a\":1}"), second("{\"b\":2}"), reads(0) {}
+      int_type underflow() {
+        std::string& chunk = reads == 0 ? first : second;
+        if (reads++ >= 2) return traits_type::eof();
+        setg(&chunk[0], &chunk[0], &chunk[0] + chunk.size());
+        return traits_type::to_int_type(chunk[0]);
+      }
+      std::string first, second;
+      int reads;
+    };
+    PipeBuffer buffer;
+    std::istream json(&buffer);
+    DynamicJsonBuffer jsonBuffer;
+
+    JsonObject& first = jsonBuffer.parseObject(json);
+    REQUIRE(1 == first["a"]);
+    REQUIRE(1 == buffer.reads);
+
+    JsonObject& second = jsonBuffer.parseObject(json);
+    REQUIRE(2 == second["b"]);
+    REQUIRE(2 == buffer.reads);
+  }
+
+  SECTION("CommentAcrossChunks") {
+    for (size_t i = 1000; i < 1040; i++) {
+      std::istringstream json(std::string(i, ' ') + "[1,/*,2*/3//\n]");
+      DynamicJsonBuffer jsonBuffer;
+      JsonArray& arr = jsonBuffer.parseArray(json);
+      REQUIRE(2 == arr.size());
+      REQUIRE(3 == arr[1]);
+    }
+  }
+
+  SECTION("SetsEofAtTheEnd") {
+    std::istringstream json("42");
+    DynamicJsonBuffer jsonBuffer;
+    REQUIRE(42 == jsonBuffer.parse(json));
+    REQUIRE(json.eof());
+  }
 }
@@ -4,6 +4,8 @@
 
 #include <ArduinoJson/Polyfills/parseFloat.hpp>
 #include <catch.hpp>
+#include <stdio.h>
+#include <stdlib.h>
 
 using namespace ArduinoJson::Internals;
 
@@ -175,3 +177,59 @@ TEST_CASE("parseFloat<double>()") {
     check<double>("true", 1.0);
   }
 }
+
+#if ARDUINOJSON_ENABLE_FAST_FLOAT
+// strtod() and strtof() are correctly rounded with glibc
+template <typename T>
+void checkExact(const char* input) {
+  CAPTURE(input);
+  T expected = sizeof(T) == 8 ? T(strtod(input, NULL))
+                              : T(strtof(input, NULL));
+  REQUIRE(parseFloat<T>(input) == expected);
+}
+
+TEST_CASE("parseFloat() is correctly rounded") {
+  SECTION("Hard cases") {
+    const char* inputs[] = {
+        "9007199254740993",
+        "9007199254740992.5",
+        "0.1",
+        "0.3",
+        "2.2250738585072011e-308",
+        "4.9406564584124654e-324",
+        "2.4703282292062328e-324",
+        "1.7976931348623158e308",
+        "7.038531e-26",
+        "1.00000005960464477539062499",
+        "1.000000059604644775390625",
+        "1.00000005960464477539062501",
+        "3.4028235677973366e38",
+        "1.4012984643e-45",
+        "179769313486231580793728971405301e276",
+        "0.000000000000000000000000000000000000000000001",
+        "123456789012345678901234567890",
+        "-45.12345678901234567",
+        "1e23",
+        "8.98846567431158e307",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      checkExact<double>(inputs[i]);
+      checkExact<float>(inputs[i]);
+    }
+  }
+
+  SECTION("Coordinates") {
+    char input[32];
+    unsigned seed = 42;
+    for (int i = 0; i < 10000; i++) {
+      seed = seed * 1103515245 + 12345;
+      unsigned integral = (seed >> 8) % 180;
+      seed = seed * 1103515245 + 12345;
+      unsigned decimals = (seed >> 4) % 100000000;
+      sprintf(input, "-%u.%08u%u", integral, decimals, i % 10);
+      checkExact<double>(input);
+      checkExact<float>(input);
+    }
+  }
+}
+#endif
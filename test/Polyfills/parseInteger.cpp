@@ -15,6 +15,22 @@ void check(const char* input, T expected) {
   REQUIRE(expected == actual);
 }
 
+template <typename T>
+void checkExact(const char* input, T expected) {
+  CAPTURE(input);
+  T actual = 0;
+  REQUIRE(parseInteger<T>(input, actual));
+  REQUIRE(expected == actual);
+}
+
+template <typename T>
+void checkFails(const char* input) {
+  CAPTURE(input);
+  T actual = 42;
+  REQUIRE_FALSE(parseInteger<T>(input, actual));
+  REQUIRE(42 == actual);
+}
+
 TEST_CASE("parseInteger<int8_t>()") {
   check<int8_t>("-128", -128);
   check<int8_t>("127", 127);
@@ -77,3 +93,84 @@ TEST_CASE("parseInteger<uint16_t>()") {
   check<uint16_t>("true", 1);
   check<uint16_t>("false", 0);
 }
+
+TEST_CASE("parseInteger<uint32_t>()") {
+  check<uint32_t>("12345678", 12345678);
+  check<uint32_t>("123456789", 123456789);
+  check<uint32_t>("0000000000000001234", 1234);
+  check<uint32_t>("4294967295", 4294967295U);
+  check<uint32_t>("4294967296", 0);
+  check<uint32_t>("99999999999999999999", 1661992959);
+  check<uint32_t>("12345678x", 12345678);
+}
+
+TEST_CASE("parseInteger<int8_t>(const char*, int8_t&)") {
+  checkExact<int8_t>("-128", -128);
+  checkExact<int8_t>("127", 127);
+  checkExact<int8_t>("+127", 127);
+  checkExact<int8_t>("-0", 0);
+  checkFails<int8_t>("128");
+  checkFails<int8_t>("-129");
+  checkFails<int8_t>("1000000000000000000000000");
+  checkFails<int8_t>("3.14");
+  checkFails<int8_t>("42x");
+  checkFails<int8_t>("x42");
+  checkFails<int8_t>("-");
+  checkFails<int8_t>("");
+  checkFails<int8_t>(NULL);
+  checkFails<int8_t>("true");
+}
+
+TEST_CASE("parseInteger<uint8_t>(const char*, uint8_t&)") {
+  checkExact<uint8_t>("0", 0);
+  checkExact<uint8_t>("255", 255);
+  checkExact<uint8_t>("-0", 0);
+  checkFails<uint8_t>("256");
+  checkFails<uint8_t>("-1");
+}
+
+TEST_CASE("parseInteger<int32_t>(const char*, int32_t&)") {
+  checkExact<int32_t>("-2147483648", -2147483647 - 1);
+  checkExact<int32_t>("2147483647", 2147483647);
+  checkExact<int32_t>("000000000000000000000000042", 42);
+  checkFails<int32_t>("2147483648");
+  checkFails<int32_t>("-2147483649");
+  checkFails<int32_t>("12345678.9");
+}
+
+TEST_CASE("parseInteger<uint32_t>(const char*, uint32_t&)") {
+  checkExact<uint32_t>("4294967295", 4294967295U);
+  checkFails<uint32_t>("4294967296");
+  checkFails<uint32_t>("10000000000000000");
+}
+
+#if ARDUINOJSON_USE_LONG_LONG || ARDUINOJSON_USE_INT64
+TEST_CASE("parseInteger<long long>(const char*, long long&)") {
+  checkExact<long long>("1234567890123456789", 1234567890123456789);
+  checkExact<long long>("9223372036854775807", 9223372036854775807);
+  checkExact<long long>("-9223372036854775808", -9223372036854775807 - 1);
+  checkFails<long long>("9223372036854775808");
+  checkFails<long long>("-9223372036854775809");
+}
+
+TEST_CASE("parseInteger<unsigned long long>(const char*, ...&)") {
+  checkExact<unsigned long long>("18446744073709551615",
+                                 18446744073709551615U);
+  checkFails<unsigned long long>("18446744073709551616");
+  checkFails<unsigned long long>("99999999999999999999");
+}
+#endif
+
+TEST_CASE("parseInteger() with every number of digits") {
+  unsigned long expected = 0;
+  char input[32] = "";
+  for (size_t i = 0; i < 9; i++) {
+    // "1", "12", "123", ..., "123456789"
+    input[i] = char('1' + i);
+    input[i + 1] = 0;
+    expected = expected * 10 + (i + 1);
+
+    check<unsigned long>(input, expected);
+    checkExact<unsigned long>(input, expected);
+  }
+}
@@ -0,0 +1,78 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson/Polyfills/scan.hpp>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+TEST_CASE("skipSpaces()") {
+  SECTION("No space") {
+    const char* s = "hello";
+    REQUIRE(skipSpaces(s) == s);
+  }
+
+  SECTION("Empty string") {
+    const char* s = "";
+    REQUIRE(skipSpaces(s) == s);
+  }
+
+  SECTION("Only spaces") {
+    const char* s = " \t\r\n";
+    REQUIRE(skipSpaces(s) == s + 4);
+  }
+
+  SECTION("Every length and every alignment") {
+    // 64 bytes of margin so that the scan can cross several blocks
+    char buffer[256];
+    for (size_t offset = 0; offset < 64; offset++) {
+      for (size_t length = 0; length < 100; length++) {
+        char* s = buffer + offset;
+        for (size_t i = 0; i < length; i++) s[i] = " \t\r\n"[i % 4];
+        s[length] = 'x';
+        s[length + 1] = '\0';
+        CAPTURE(offset);
+        CAPTURE(length);
+        REQUIRE(skipSpaces(s) == s + length);
+        s[length] = '\0';
+        REQUIRE(skipSpaces(s) == s + length);
+      }
+    }
+  }
+}
+
+TEST_CASE("findChar()") {
+  SECTION("Found at the beginning") {
+    const char* s = "*/";
+    REQUIRE(findChar(s, '*') == s);
+  }
+
+  SECTION("Not found") {
+    const char* s = "hello";
+    REQUIRE(findChar(s, '*') == s + 5);
+  }
+
+  SECTION("Returns the first occurrence") {
+    const char* s = "a comment */ */";
+    REQUIRE(findChar(s, '*') == s + 10);
+  }
+
+  SECTION("Every length and every alignment") {
+    char buffer[256];
+    for (size_t offset = 0; offset < 64; offset++) {
+      for (size_t length = 0; length < 100; length++) {
+        char* s = buffer + offset;
+        for (size_t i = 0; i < length; i++) s[i] = 'a';
+        s[length] = '\n';
+        s[length + 1] = '\0';
+        CAPTURE(offset);
+        CAPTURE(length);
+        REQUIRE(findChar(s, '\n') == s + length);
+        s[length] = '\0';
+        REQUIRE(findChar(s, '\n') == s + length);
+      }
+    }
+  }
+}